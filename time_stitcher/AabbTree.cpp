@@ -0,0 +1,200 @@
+#include "AabbTree.h"
+#include <cassert>
+
+namespace {
+    // moving boxes are stretched this many steps of their displacement ahead
+    constexpr float DisplacementAhead = 4.f;
+}
+
+int AabbTree::allocate() {
+    if (m_free == Null) {
+        m_nodes.emplace_back();
+        m_nodes.back().height = 0;
+        return static_cast<int>(m_nodes.size()) - 1;
+    }
+    const int id = m_free;
+    m_free = m_nodes[id].parent;
+    m_nodes[id] = Node{};
+    m_nodes[id].height = 0;
+    return id;
+}
+
+void AabbTree::release(int id) {
+    m_nodes[id].parent = m_free;
+    m_nodes[id].height = -1;
+    m_nodes[id].child1 = m_nodes[id].child2 = Null;
+    m_nodes[id].moved = false;
+    m_free = id;
+}
+
+void AabbTree::clear() {
+    m_nodes.clear();
+    m_moved.clear();
+    m_root = Null;
+    m_free = Null;
+    m_leaves = 0;
+}
+
+int AabbTree::insert(const sf::FloatRect& box, std::uint32_t userData) {
+    const int id = allocate();
+    Node& node = m_nodes[id];
+    node.box = Box::of(box);
+    node.box.min -= { m_margin, m_margin };
+    node.box.max += { m_margin, m_margin };
+    node.userData = userData;
+    node.moved = true;
+    insertLeaf(id);
+    m_moved.push_back(id);
+    ++m_leaves;
+    return id;
+}
+
+void AabbTree::remove(int proxy) {
+    assert(proxy >= 0 and proxy < static_cast<int>(m_nodes.size()) and m_nodes[proxy].leaf());
+    removeLeaf(proxy);
+    release(proxy);
+    --m_leaves;
+}
+
+bool AabbTree::move(int proxy, const sf::FloatRect& box, sf::Vector2f displacement) {
+    const Box tight = Box::of(box);
+    if (m_nodes[proxy].box.contains(tight)) return false;
+
+    removeLeaf(proxy);
+    Box fat = tight;
+    fat.min -= { m_margin, m_margin };
+    fat.max += { m_margin, m_margin };
+    // predict the next steps, so a steadily moving box leaves its fat box rarely
+    const sf::Vector2f ahead = displacement * DisplacementAhead;
+    if (ahead.x < 0.f) fat.min.x += ahead.x; else fat.max.x += ahead.x;
+    if (ahead.y < 0.f) fat.min.y += ahead.y; else fat.max.y += ahead.y;
+    m_nodes[proxy].box = fat;
+    insertLeaf(proxy);
+
+    if (not m_nodes[proxy].moved) {
+        m_nodes[proxy].moved = true;
+        m_moved.push_back(proxy);
+    }
+    return true;
+}
+
+void AabbTree::insertLeaf(int leaf) {
+    if (m_root == Null) {
+        m_root = leaf;
+        m_nodes[leaf].parent = Null;
+        return;
+    }
+
+    // find the best sibling: at every inner node compare making it the sibling against
+    // descending into either child, counting the growth of all ancestors on the way
+    const Box leafBox = m_nodes[leaf].box;
+    int index = m_root;
+    while (not m_nodes[index].leaf()) {
+        const Node& node = m_nodes[index];
+        const float area = node.box.perimeter();
+        const float combinedArea = node.box.merged(leafBox).perimeter();
+        const float cost = 2.f * combinedArea;
+        const float inheritance = 2.f * (combinedArea - area);
+
+        auto descend = [&](int child) {
+            const Box& childBox = m_nodes[child].box;
+            const float grown = childBox.merged(leafBox).perimeter();
+            return (m_nodes[child].leaf() ? grown : grown - childBox.perimeter()) + inheritance;
+        };
+        const float cost1 = descend(node.child1);
+        const float cost2 = descend(node.child2);
+        if (cost < cost1 and cost < cost2) break;
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    // new parent for the sibling and the leaf
+    const int sibling = index;
+    const int oldParent = m_nodes[sibling].parent;
+    const int parent = allocate();
+    m_nodes[parent].parent = oldParent;
+    m_nodes[parent].box = leafBox.merged(m_nodes[sibling].box);
+    m_nodes[parent].height = m_nodes[sibling].height + 1;
+    m_nodes[parent].child1 = sibling;
+    m_nodes[parent].child2 = leaf;
+    m_nodes[sibling].parent = parent;
+    m_nodes[leaf].parent = parent;
+    if (oldParent == Null) m_root = parent;
+    else if (m_nodes[oldParent].child1 == sibling) m_nodes[oldParent].child1 = parent;
+    else m_nodes[oldParent].child2 = parent;
+
+    refit(m_nodes[leaf].parent);
+}
+
+void AabbTree::removeLeaf(int leaf) {
+    if (leaf == m_root) {
+        m_root = Null;
+        return;
+    }
+    const int parent = m_nodes[leaf].parent;
+    const int grandParent = m_nodes[parent].parent;
+    const int sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    if (grandParent == Null) {
+        m_root = sibling;
+        m_nodes[sibling].parent = Null;
+        release(parent);
+        return;
+    }
+    if (m_nodes[grandParent].child1 == parent) m_nodes[grandParent].child1 = sibling;
+    else m_nodes[grandParent].child2 = sibling;
+    m_nodes[sibling].parent = grandParent;
+    release(parent);
+    refit(grandParent);
+}
+
+// walks up from `id`, rebalancing and fixing heights and boxes
+void AabbTree::refit(int id) {
+    while (id != Null) {
+        id = balance(id);
+        Node& node = m_nodes[id];
+        const Node& c1 = m_nodes[node.child1];
+        const Node& c2 = m_nodes[node.child2];
+        node.height = 1 + std::max(c1.height, c2.height);
+        node.box = c1.box.merged(c2.box);
+        id = node.parent;
+    }
+}
+
+// If one child of `a` is more than one level higher than the other, rotates that child up:
+// it takes a's place and a takes the shorter of its children. Returns the node now at a's place.
+int AabbTree::balance(int a) {
+    Node& A = m_nodes[a];
+    if (A.leaf() or A.height < 2) return a;
+
+    const int b = A.child1, c = A.child2;
+    const int diff = m_nodes[c].height - m_nodes[b].height;
+    if (diff >= -1 and diff <= 1) return a;
+
+    // rotate the higher child up
+    const int up = diff > 1 ? c : b;
+    const int other = diff > 1 ? b : c;
+    Node& U = m_nodes[up];
+    const int f = U.child1, g = U.child2;
+
+    U.child1 = a;
+    U.parent = A.parent;
+    A.parent = up;
+    if (U.parent == Null) m_root = up;
+    else if (m_nodes[U.parent].child1 == a) m_nodes[U.parent].child1 = up;
+    else m_nodes[U.parent].child2 = up;
+
+    // the higher grandchild stays with `up`, the other one replaces `up` under a
+    const bool fHigher = m_nodes[f].height > m_nodes[g].height;
+    const int keep = fHigher ? f : g;
+    const int give = fHigher ? g : f;
+    U.child2 = keep;
+    if (diff > 1) A.child2 = give;
+    else A.child1 = give;
+    m_nodes[give].parent = a;
+
+    A.box = m_nodes[other].box.merged(m_nodes[give].box);
+    A.height = 1 + std::max(m_nodes[other].height, m_nodes[give].height);
+    U.box = A.box.merged(m_nodes[keep].box);
+    U.height = 1 + std::max(A.height, m_nodes[keep].height);
+    return up;
+}
@@ -0,0 +1,166 @@
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Incrementally updated bounding volume hierarchy for boxes that may move (as in Box2D's
+// b2DynamicTree). Leaves store a "fat" box: the real box grown by a margin and, for moving
+// boxes, stretched along their displacement. A box that moves inside its fat box doesn't
+// touch the tree at all. Insertion picks the sibling with the surface area heuristic (cheapest
+// growth of perimeters along the path), and rotations on the way back up keep it balanced.
+// Proxy ids are stable until removed; nodes are recycled through a free list.
+class AabbTree {
+public:
+    static constexpr int Null = -1;
+
+    explicit AabbTree(float margin = 4.f) : m_margin(margin) {}
+
+    int insert(const sf::FloatRect& box, std::uint32_t userData);
+    void remove(int proxy);
+    // true if the box left its fat box and the proxy was reinserted
+    bool move(int proxy, const sf::FloatRect& box, sf::Vector2f displacement = { 0.f, 0.f });
+    void clear();
+
+    sf::FloatRect fatBox(int proxy) const { return m_nodes[proxy].box.rect(); }
+    std::uint32_t userData(int proxy) const { return m_nodes[proxy].userData; }
+    std::size_t size() const { return m_leaves; }
+    int height() const { return m_root == Null ? 0 : m_nodes[m_root].height; }
+    void reserve(std::size_t proxies) { m_nodes.reserve(2 * proxies); }
+
+    // callback(proxy) for every fat box overlapping `area`; return false to stop
+    template <class F>
+    void query(const sf::FloatRect& area, F&& callback) const {
+        const Box box = Box::of(area);
+        m_stack.clear();
+        if (m_root != Null) m_stack.push_back(m_root);
+        while (not m_stack.empty()) {
+            const Node& node = m_nodes[m_stack.back()];
+            const int id = m_stack.back();
+            m_stack.pop_back();
+            if (not node.box.overlaps(box)) continue;
+            if (node.leaf()) {
+                if (not callback(id)) return;
+            }
+            else {
+                m_stack.push_back(node.child1);
+                m_stack.push_back(node.child2);
+            }
+        }
+    }
+
+    // callback(proxy, maxFraction) for the fat boxes the segment from..to crosses before
+    // maxFraction (0..1 along the segment). It returns the new maxFraction: the fraction of a
+    // hit clips the ray, 0 stops, maxFraction as passed goes on unchanged.
+    template <class F>
+    void raycast(sf::Vector2f from, sf::Vector2f to, F&& callback) const {
+        const sf::Vector2f d = to - from;
+        float maxFraction = 1.f;
+        m_stack.clear();
+        if (m_root != Null) m_stack.push_back(m_root);
+        while (not m_stack.empty()) {
+            const int id = m_stack.back();
+            m_stack.pop_back();
+            const Node& node = m_nodes[id];
+            if (not node.box.crosses(from, d, maxFraction)) continue;
+            if (node.leaf()) {
+                const float fraction = callback(id, maxFraction);
+                if (fraction == 0.f) return;
+                maxFraction = std::min(maxFraction, fraction);
+            }
+            else {
+                m_stack.push_back(node.child1);
+                m_stack.push_back(node.child2);
+            }
+        }
+    }
+
+    // callback(a, b) once for every pair of overlapping fat boxes
+    template <class F>
+    void pairs(F&& callback) const {
+        for (int id = 0; id < static_cast<int>(m_nodes.size()); ++id) {
+            const Node& node = m_nodes[id];
+            if (node.height != 0) continue; // inner or free node
+            forEachOverlap(id, [&](int other) { if (other > id) callback(id, other); });
+        }
+    }
+
+    // like pairs(), but only the pairs with a proxy that was inserted or reinserted since the
+    // last call; pairs of resting proxies are unchanged. Clears the moved list.
+    template <class F>
+    void movedPairs(F&& callback) {
+        // a removed proxy's id can come back through a new insert
+        std::sort(m_moved.begin(), m_moved.end());
+        m_moved.erase(std::unique(m_moved.begin(), m_moved.end()), m_moved.end());
+        for (int id : m_moved) {
+            if (not m_nodes[id].moved) continue; // removed meanwhile
+            forEachOverlap(id, [&](int other) {
+                // two moved proxies: report the pair once
+                if (m_nodes[other].moved and other < id) return;
+                callback(id, other);
+            });
+        }
+        for (int id : m_moved) m_nodes[id].moved = false;
+        m_moved.clear();
+    }
+
+private:
+    struct Box {
+        sf::Vector2f min, max;
+
+        static Box of(const sf::FloatRect& r) { return { r.position, r.position + r.size }; }
+        sf::FloatRect rect() const { return { min, max - min }; }
+        float perimeter() const { return 2.f * ((max.x - min.x) + (max.y - min.y)); }
+        Box merged(const Box& o) const {
+            return { { std::min(min.x, o.min.x), std::min(min.y, o.min.y) }, { std::max(max.x, o.max.x), std::max(max.y, o.max.y) } };
+        }
+        bool contains(const Box& o) const { return min.x <= o.min.x and min.y <= o.min.y and o.max.x <= max.x and o.max.y <= max.y; }
+        bool overlaps(const Box& o) const { return min.x <= o.max.x and o.min.x <= max.x and min.y <= o.max.y and o.min.y <= max.y; }
+        // does from + t * d for t in [0, maxT] touch the box; separating axes without divisions
+        // (the two box axes and the segment normal), as b2DynamicTree does
+        bool crosses(sf::Vector2f from, sf::Vector2f d, float maxT) const {
+            const sf::Vector2f to = from + d * maxT;
+            if (std::max(from.x, to.x) < min.x or std::min(from.x, to.x) > max.x) return false;
+            if (std::max(from.y, to.y) < min.y or std::min(from.y, to.y) > max.y) return false;
+            const sf::Vector2f c = (min + max) * 0.5f, h = (max - min) * 0.5f;
+            const float separation = std::abs(d.x * (from.y - c.y) - d.y * (from.x - c.x));
+            return separation <= std::abs(d.y) * h.x + std::abs(d.x) * h.y;
+        }
+    };
+
+    struct Node {
+        Box box;
+        int parent = Null;   // next free node while on the free list
+        int child1 = Null;
+        int child2 = Null;
+        int height = -1;     // 0: leaf, -1: free
+        std::uint32_t userData = 0;
+        bool moved = false;
+
+        bool leaf() const { return child1 == Null; }
+    };
+
+    template <class F>
+    void forEachOverlap(int proxy, F&& callback) const {
+        query(m_nodes[proxy].box.rect(), [&](int other) {
+            if (other != proxy) callback(other);
+            return true;
+        });
+    }
+
+    int allocate();
+    void release(int id);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int balance(int a);
+    void refit(int id);
+
+    float m_margin;
+    std::vector<Node> m_nodes;
+    int m_root = Null;
+    int m_free = Null;
+    std::size_t m_leaves = 0;
+    std::vector<int> m_moved;
+    mutable std::vector<int> m_stack; // traversal scratch, queries are not reentrant
+};
@@ -0,0 +1,95 @@
+#include "Animation.h"
+#include "MemoryTracker.h"
+#include <algorithm>
+#include <iostream>
+
+const sf::Texture& AnimationSet::own(std::unique_ptr<sf::Texture> texture) {
+    m_textures.push_back(std::move(texture));
+    return *m_textures.back();
+}
+
+std::uint32_t AnimationSet::addFrame(const sf::Texture& texture) {
+    sf::Vector2i size(texture.getSize());
+    return addFrame(texture, sf::IntRect({ 0, 0 }, size));
+}
+
+std::uint32_t AnimationSet::addFrame(const sf::Texture& texture, const sf::IntRect& rect) {
+    AnimationFrame frame;
+    frame.texture = &texture;
+    frame.rect = rect;
+    frame.origin = { rect.size.x * 0.5f, rect.size.y * 0.5f };
+    m_frames.push_back(frame);
+    return static_cast<std::uint32_t>(m_frames.size() - 1);
+}
+
+std::uint32_t AnimationSet::addClip(std::uint32_t first, std::uint32_t count, float frameTime) {
+    m_clips.push_back({ first, count, frameTime });
+    return static_cast<std::uint32_t>(m_clips.size() - 1);
+}
+
+void AnimationSet::setFrameTime(float frameTime) {
+    for (auto& clip : m_clips) clip.frameTime = frameTime;
+}
+
+AnimationSet AnimationSet::packed() const {
+    AnimationSet out;
+    if (m_frames.empty()) return out;
+
+    // every frame gets a 1 px border repeating its edge pixels: the atlas is drawn magnified and
+    // smoothed, and filtering at a frame's edge would otherwise blend in its neighbour
+    constexpr int Gutter = 1;
+    sf::Vector2u size{ 0, 0 };
+    for (const auto& frame : m_frames) {
+        size.x += static_cast<unsigned>(frame.rect.size.x + 2 * Gutter);
+        size.y = std::max(size.y, static_cast<unsigned>(frame.rect.size.y + 2 * Gutter));
+    }
+    if (size.x > sf::Texture::getMaximumSize()) {
+        std::cerr << "Animation frames don't fit into one texture (" << size.x << " px wide)\n";
+        return out;
+    }
+
+    // load time only: reads every frame back from the gpu once
+    sf::Image atlas(size, sf::Color::Transparent);
+    int x = 0;
+    for (const auto& frame : m_frames) {
+        sf::Image source = frame.texture->copyToImage();
+        const sf::IntRect& r = frame.rect;
+        if (r.position.x < 0 or r.position.y < 0 or r.size.x <= 0 or r.size.y <= 0
+            or static_cast<unsigned>(r.position.x + r.size.x) > source.getSize().x
+            or static_cast<unsigned>(r.position.y + r.size.y) > source.getSize().y) {
+            std::cerr << "Failed to pack animation frame\n";
+            return out;
+        }
+        const int w = r.size.x + 2 * Gutter, h = r.size.y + 2 * Gutter;
+        for (int j = 0; j < h; ++j) {
+            const int sy = r.position.y + std::clamp(j - Gutter, 0, r.size.y - 1);
+            for (int i = 0; i < w; ++i) {
+                const int sx = r.position.x + std::clamp(i - Gutter, 0, r.size.x - 1);
+                atlas.setPixel(sf::Vector2u(sf::Vector2i(x + i, j)), source.getPixel(sf::Vector2u(sf::Vector2i(sx, sy))));
+            }
+        }
+        x += w;
+    }
+
+    auto texture = std::make_unique<sf::Texture>();
+    if (not texture->loadFromImage(atlas)) {
+        std::cerr << "Failed to create animation atlas\n";
+        return out;
+    }
+    texture->setSmooth(m_frames.front().texture->isSmooth());
+
+    const sf::Texture& owned = out.own(std::move(texture));
+    int left = 0;
+    for (const auto& frame : m_frames) {
+        out.addFrame(owned, sf::IntRect({ left + Gutter, Gutter }, frame.rect.size));
+        left += frame.rect.size.x + 2 * Gutter;
+    }
+    out.m_clips = m_clips;
+    return out;
+}
+
+std::size_t AnimationSet::textureBytes() const {
+    std::size_t total = 0;
+    for (const auto& texture : m_textures) total += memory::textureBytes(*texture);
+    return total;
+}
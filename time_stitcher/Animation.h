@@ -0,0 +1,83 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// One frame: texture, the part of it to show and the origin that centers it (precomputed).
+struct AnimationFrame {
+    const sf::Texture* texture = nullptr;
+    sf::IntRect rect;
+    sf::Vector2f origin;
+};
+
+// A run of consecutive frames inside an AnimationSet.
+struct AnimationClip {
+    std::uint32_t first = 0;
+    std::uint32_t count = 1;
+    float frameTime = 0.1f; // seconds per frame
+};
+
+// Playback state of one animated instance. Many instances can share one AnimationSet.
+struct AnimationState {
+    std::uint32_t clip = 0;
+    std::uint32_t frame = 0; // absolute index into the set's frames
+    float timer = 0.f;
+};
+
+// Frames of all clips back to back in one flat array, plus the clips pointing into it.
+// Built once at load time; playing an animation is then plain index arithmetic.
+class AnimationSet {
+public:
+    // keeps a texture loaded for this set alive as long as the set
+    const sf::Texture& own(std::unique_ptr<sf::Texture> texture);
+
+    // frame showing the whole texture; the texture must outlive the set
+    std::uint32_t addFrame(const sf::Texture& texture);
+    std::uint32_t addFrame(const sf::Texture& texture, const sf::IntRect& rect);
+    std::uint32_t addClip(std::uint32_t first, std::uint32_t count, float frameTime);
+
+    const AnimationFrame& frame(std::uint32_t i) const { return m_frames[i]; }
+    const AnimationClip& clip(std::uint32_t i) const { return m_clips[i]; }
+    std::size_t frameCount() const { return m_frames.size(); }
+    std::size_t clipCount() const { return m_clips.size(); }
+
+    void setFrameTime(float frameTime);
+    // copy of this set with all frames packed side by side (edge pixels repeated around each)
+    // into one owned texture, so instances can be batched into a single draw (AnimationBatch);
+    // empty if packing failed
+    AnimationSet packed() const;
+    // estimated video memory of the owned textures
+    std::size_t textureBytes() const;
+
+private:
+    std::vector<AnimationFrame> m_frames;
+    std::vector<AnimationClip> m_clips;
+    std::vector<std::unique_ptr<sf::Texture>> m_textures;
+};
+
+namespace animation {
+    // restarts `state` on the first frame of `clip`
+    inline void play(const AnimationSet& set, AnimationState& state, std::uint32_t clip) {
+        state.clip = clip;
+        state.frame = set.clip(clip).first;
+        state.timer = 0.f;
+    }
+
+    // advances the timer by dt; true if the shown frame changed
+    inline bool step(const AnimationSet& set, AnimationState& state, float dt) {
+        const AnimationClip& clip = set.clip(state.clip);
+        state.timer += dt;
+        if (state.timer < clip.frameTime) return false;
+        state.timer -= clip.frameTime;
+        std::uint32_t next = state.frame + 1;
+        state.frame = next == clip.first + clip.count ? clip.first : next;
+        return clip.count > 1;
+    }
+
+    inline void apply(const AnimationFrame& frame, sf::Sprite& sprite) {
+        sprite.setTexture(*frame.texture);
+        sprite.setTextureRect(frame.rect);
+        sprite.setOrigin(frame.origin);
+    }
+}
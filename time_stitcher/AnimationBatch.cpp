@@ -0,0 +1,140 @@
+#include "AnimationBatch.h"
+#include <limits>
+
+void AnimationBatch::setAnimations(const AnimationSet* set) {
+    m_set = set;
+    clear();
+}
+
+void AnimationBatch::clear() {
+    m_timer.clear();
+    m_frameTime.clear();
+    m_frame.clear();
+    m_first.clear();
+    m_end.clear();
+    m_clip.clear();
+    m_changed.clear();
+    m_halfSize.clear();
+    m_free.clear();
+    m_vertices.clear();
+}
+
+void AnimationBatch::reserve(std::size_t instances) {
+    m_timer.reserve(instances);
+    m_frameTime.reserve(instances);
+    m_frame.reserve(instances);
+    m_first.reserve(instances);
+    m_end.reserve(instances);
+    m_clip.reserve(instances);
+    m_changed.reserve(instances);
+    m_halfSize.reserve(instances);
+    m_free.reserve(instances);
+    m_vertices.reserve(instances * 6);
+}
+
+std::uint32_t AnimationBatch::add(std::uint32_t clip, const sf::Vector2f& position, const sf::Vector2f& size, sf::Color color) {
+    std::uint32_t i;
+    if (not m_free.empty()) {
+        i = m_free.back();
+        m_free.pop_back();
+    }
+    else {
+        i = static_cast<std::uint32_t>(m_timer.size());
+        m_timer.push_back(0.f);
+        m_frameTime.push_back(0.f);
+        m_frame.push_back(0);
+        m_first.push_back(0);
+        m_end.push_back(0);
+        m_clip.push_back(0);
+        m_changed.push_back(0);
+        m_halfSize.push_back({});
+        m_vertices.resize(m_vertices.size() + 6);
+    }
+    m_clip[i] = clip + 1; // anything but clip, so play() below starts it
+    m_changed[i] = 0;
+    m_halfSize[i] = size * 0.5f;
+    sf::Vertex* quad = &m_vertices[static_cast<std::size_t>(i) * 6];
+    for (int v = 0; v < 6; ++v) quad[v].color = color;
+
+    play(i, clip);
+    setPosition(i, position);
+    return i;
+}
+
+void AnimationBatch::remove(std::uint32_t i) {
+    // a transparent point that never changes frame: update() keeps its branch-free pass
+    m_halfSize[i] = {};
+    setPosition(i, {});
+    sf::Vertex* quad = &m_vertices[static_cast<std::size_t>(i) * 6];
+    for (int v = 0; v < 6; ++v) quad[v].color = sf::Color::Transparent;
+    m_frameTime[i] = std::numeric_limits<float>::infinity();
+    m_timer[i] = 0.f;
+    m_changed[i] = 0;
+    m_free.push_back(i);
+}
+
+void AnimationBatch::play(std::uint32_t i, std::uint32_t clip) {
+    if (m_clip[i] == clip or not m_set) return;
+    const AnimationClip& c = m_set->clip(clip);
+    m_clip[i] = clip;
+    m_first[i] = c.first;
+    m_end[i] = c.first + c.count;
+    m_frameTime[i] = c.frameTime;
+    m_frame[i] = c.first;
+    m_timer[i] = 0.f;
+    writeTexCoords(i);
+}
+
+void AnimationBatch::setPosition(std::uint32_t i, const sf::Vector2f& position) {
+    const sf::Vector2f h = m_halfSize[i];
+    const sf::Vector2f a = position - h, c = position + h;
+    sf::Vertex* quad = &m_vertices[static_cast<std::size_t>(i) * 6];
+    quad[0].position = a;
+    quad[1].position = { c.x, a.y };
+    quad[2].position = c;
+    quad[3].position = a;
+    quad[4].position = c;
+    quad[5].position = { a.x, c.y };
+}
+
+void AnimationBatch::writeTexCoords(std::uint32_t i) {
+    const sf::IntRect& r = m_set->frame(m_frame[i]).rect;
+    const sf::Vector2f a(r.position), c(r.position + r.size);
+    sf::Vertex* quad = &m_vertices[static_cast<std::size_t>(i) * 6];
+    quad[0].texCoords = a;
+    quad[1].texCoords = { c.x, a.y };
+    quad[2].texCoords = c;
+    quad[3].texCoords = a;
+    quad[4].texCoords = c;
+    quad[5].texCoords = { a.x, c.y };
+}
+
+void AnimationBatch::update(float dt) {
+    if (not m_set) return;
+    const std::size_t n = m_timer.size();
+    float* timer = m_timer.data();
+    const float* frameTime = m_frameTime.data();
+    std::uint32_t* frame = m_frame.data();
+    const std::uint32_t* first = m_first.data();
+    const std::uint32_t* end = m_end.data();
+    std::uint8_t* changed = m_changed.data();
+
+    // no branches and no calls: compilers turn this into simd selects
+    for (std::size_t i = 0; i < n; ++i) {
+        const float t = timer[i] + dt;
+        const bool advance = t >= frameTime[i];
+        timer[i] = advance ? t - frameTime[i] : t;
+        const std::uint32_t next = frame[i] + (advance ? 1u : 0u);
+        const std::uint32_t wrapped = next == end[i] ? first[i] : next;
+        changed[i] = wrapped != frame[i];
+        frame[i] = wrapped;
+    }
+
+    for (std::size_t i = 0; i < n; ++i)
+        if (changed[i]) writeTexCoords(static_cast<std::uint32_t>(i));
+}
+
+void AnimationBatch::draw(sf::RenderTarget& target) const {
+    if (not m_set or m_set->frameCount() == 0 or m_vertices.empty()) return;
+    target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, sf::RenderStates(m_set->frame(0).texture));
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "Animation.h"
+
+// Many animated quads sharing one AnimationSet, drawn with a single draw call.
+// Playback state is kept as parallel arrays so update() is one pass over plain numbers;
+// only instances whose frame changed get their texture coordinates rewritten.
+// All frames of the set must live on one texture (see AnimationSet::packed).
+class AnimationBatch {
+public:
+    // the set must outlive the batch; drops all instances
+    void setAnimations(const AnimationSet* set);
+    const AnimationSet* animations() const { return m_set; }
+
+    // quad of `size` centered on `position`; returns the instance index
+    std::uint32_t add(std::uint32_t clip, const sf::Vector2f& position, const sf::Vector2f& size, sf::Color color = sf::Color::White);
+    // hides instance i; its index (and quad) is handed out again by a later add()
+    void remove(std::uint32_t i);
+    void clear();
+    void reserve(std::size_t instances);
+    // instance slots, removed ones included
+    std::size_t size() const { return m_timer.size(); }
+
+    // restarts instance i on `clip` unless it already plays it
+    void play(std::uint32_t i, std::uint32_t clip);
+    void setPosition(std::uint32_t i, const sf::Vector2f& position);
+
+    void update(float dt);
+    void draw(sf::RenderTarget& target) const;
+
+private:
+    void writeTexCoords(std::uint32_t i);
+
+    const AnimationSet* m_set = nullptr;
+
+    // per instance
+    std::vector<float> m_timer;
+    std::vector<float> m_frameTime;
+    std::vector<std::uint32_t> m_frame;   // absolute frame index
+    std::vector<std::uint32_t> m_first;   // clip frames are [first, end)
+    std::vector<std::uint32_t> m_end;
+    std::vector<std::uint32_t> m_clip;
+    std::vector<std::uint8_t> m_changed;  // frame advanced in the last update
+    std::vector<sf::Vector2f> m_halfSize;
+    std::vector<std::uint32_t> m_free;    // removed instances
+
+    // 6 per instance; a plain vector rather than an sf::VertexArray, whose element access is a
+    // call into the library for every quad written
+    std::vector<sf::Vertex> m_vertices;
+};
@@ -0,0 +1,251 @@
+#include "ChunkWorld.h"
+#include "MemoryTracker.h"
+#include "GreedyMesh.h"
+#include <algorithm>
+#include <cmath>
+
+ChunkWorld::ChunkWorld(JobSystem& jobs)
+    : m_jobs(jobs), m_shared(std::make_shared<Shared>())
+{
+    setRadius(m_radius);
+}
+
+void ChunkWorld::setRadius(int chunks) {
+    m_radius = chunks;
+    const std::size_t maxChunks = static_cast<std::size_t>(2 * chunks + 3) * (2 * chunks + 3);
+    m_entries.reserve(maxChunks);
+    m_arrived.reserve(maxChunks);
+    m_orphans.reserve(maxChunks);
+    {
+        std::lock_guard<std::mutex> lock(m_shared->mutex);
+        m_shared->ready.reserve(maxChunks);
+    }
+    m_windowSize = 2 * chunks + 3;
+    m_window.assign(maxChunks, nullptr);
+}
+
+sf::Vector2i ChunkWorld::chunkOf(int tx, int ty) {
+    return { static_cast<int>(std::floor(tx / static_cast<float>(Chunk::Tiles))),
+             static_cast<int>(std::floor(ty / static_cast<float>(Chunk::Tiles))) };
+}
+
+void ChunkWorld::reset(const Maze& maze) {
+    m_maze = maze;
+    for (const Entry& entry : m_entries) {
+        // chunks still being built are given back once their job is done
+        if (entry.loaded) m_shared->pool.release(entry.handle);
+        else m_orphans.push_back(entry.handle);
+    }
+    m_entries.clear();
+    std::fill(m_window.begin(), m_window.end(), nullptr);
+}
+
+void ChunkWorld::build(const Maze& maze, sf::Vector2i coord, Chunk& chunk) {
+    chunk.coord = coord;
+
+    const int baseX = coord.x * Chunk::Tiles;
+    const int baseY = coord.y * Chunk::Tiles;
+    const float ts = Maze::TileSize;
+    std::array<std::uint64_t, Chunk::Tiles> merge;
+
+    for (int y = 0; y < Chunk::Tiles; ++y) {
+        std::uint32_t bits = 0;
+        for (int x = 0; x < Chunk::Tiles; ++x) {
+            if (maze.isWall(baseX + x, baseY + y))
+                bits |= 1u << x;
+        }
+        chunk.rows[y] = bits;
+        merge[y] = bits;
+    }
+
+    // clear and resize keep the capacity of a recycled chunk
+    chunk.walls.clear();
+    meshing::greedyRects(merge, chunk.walls, { baseX, baseY });
+
+    chunk.geometry.resize(chunk.walls.size() * 6);
+    std::size_t v = 0;
+    for (const sf::IntRect& wall : chunk.walls) {
+        sf::Vector2f p{ wall.position.x * ts, wall.position.y * ts };
+        sf::Vector2f s{ wall.size.x * ts, wall.size.y * ts };
+        // two triangles; normalized uvs counting tiles, so a repeated texture tiles (see draw)
+        sf::Vector2f corners[4] = { p, { p.x + s.x, p.y }, p + s, { p.x, p.y + s.y } };
+        sf::Vector2f size(wall.size);
+        sf::Vector2f uv[4] = { { 0.f, 0.f }, { size.x, 0.f }, size, { 0.f, size.y } };
+        const int order[6] = { 0, 1, 2, 0, 2, 3 };
+        for (int i : order) {
+            chunk.geometry[v].position = corners[i];
+            chunk.geometry[v].texCoords = uv[i];
+            ++v;
+        }
+    }
+}
+
+ChunkWorld::Entry* ChunkWorld::findEntry(const sf::Vector2i& coord) {
+    for (Entry& entry : m_entries)
+        if (entry.coord == coord) return &entry;
+    return nullptr;
+}
+
+std::size_t ChunkWorld::loadedChunks() const {
+    return static_cast<std::size_t>(std::count_if(m_entries.begin(), m_entries.end(), [](const Entry& e) { return e.loaded; }));
+}
+
+const Chunk* ChunkWorld::find(int cx, int cy) const {
+    int x = cx - m_windowOrigin.x, y = cy - m_windowOrigin.y;
+    if (x < 0 or y < 0 or x >= m_windowSize or y >= m_windowSize) return nullptr;
+    return m_window[static_cast<std::size_t>(y) * m_windowSize + x];
+}
+
+void ChunkWorld::rebuildWindow() {
+    std::fill(m_window.begin(), m_window.end(), nullptr);
+    for (const Entry& entry : m_entries) {
+        if (not entry.loaded) continue;
+        int x = entry.coord.x - m_windowOrigin.x, y = entry.coord.y - m_windowOrigin.y;
+        if (x < 0 or y < 0 or x >= m_windowSize or y >= m_windowSize) continue;
+        m_window[static_cast<std::size_t>(y) * m_windowSize + x] = m_shared->pool.get(entry.handle);
+    }
+}
+
+void ChunkWorld::prime(const sf::Vector2f& focus) {
+    sf::Vector2i tile = m_maze.tileAt(focus);
+    sf::Vector2i coord = chunkOf(tile.x, tile.y);
+    if (findEntry(coord)) return;
+
+    PoolHandle handle = m_shared->pool.acquire();
+    build(m_maze, coord, *m_shared->pool.get(handle));
+    m_entries.push_back({ coord, handle, true });
+    m_windowOrigin = coord - sf::Vector2i{ m_radius + 1, m_radius + 1 };
+    rebuildWindow();
+}
+
+void ChunkWorld::update(const sf::Vector2f& focus) {
+    Shared& shared = *m_shared;
+
+    // 1) pick up finished chunks
+    {
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        m_arrived.swap(shared.ready);
+    }
+    for (PoolHandle handle : m_arrived) {
+        auto orphan = std::find(m_orphans.begin(), m_orphans.end(), handle);
+        if (orphan != m_orphans.end()) {
+            shared.pool.release(handle);
+            m_orphans.erase(orphan);
+            continue;
+        }
+        for (Entry& entry : m_entries)
+            if (entry.handle == handle) entry.loaded = true;
+    }
+    m_arrived.clear();
+
+    sf::Vector2i tile = m_maze.tileAt(focus);
+    const sf::Vector2i f = chunkOf(tile.x, tile.y);
+
+    // 2) drop chunks outside radius + 1 (the extra ring avoids load/unload flicker on borders);
+    //    chunks still building stay until they are done
+    for (std::size_t i = 0; i < m_entries.size();) {
+        const Entry& entry = m_entries[i];
+        bool far = std::abs(entry.coord.x - f.x) > m_radius + 1 or std::abs(entry.coord.y - f.y) > m_radius + 1;
+        if (far and entry.loaded) {
+            shared.pool.release(entry.handle);
+            m_entries[i] = m_entries.back();
+            m_entries.pop_back();
+        }
+        else ++i;
+    }
+
+    // 3) request missing chunks inside the radius, nearest ring first
+    const int maxX = (m_maze.width() - 1) / Chunk::Tiles;
+    const int maxY = (m_maze.height() - 1) / Chunk::Tiles;
+    for (int r = 0; r <= m_radius; ++r) {
+        for (int cy = f.y - r; cy <= f.y + r; ++cy) {
+            for (int cx = f.x - r; cx <= f.x + r; ++cx) {
+                if (std::abs(cx - f.x) != r and std::abs(cy - f.y) != r) continue; // ring only
+                if (cx < 0 or cy < 0 or cx > maxX or cy > maxY) continue;
+                if (findEntry({ cx, cy })) continue;
+
+                PoolHandle handle = shared.pool.acquire();
+                Chunk* chunk = shared.pool.get(handle);
+                m_entries.push_back({ { cx, cy }, handle, false });
+                m_jobs.submit([keep = m_shared, chunk, handle, maze = m_maze, coord = sf::Vector2i{ cx, cy }] {
+                    memory::Scope tag(memory::Tag::Streaming);
+                    build(maze, coord, *chunk);
+                    std::lock_guard<std::mutex> lock(keep->mutex);
+                    keep->ready.push_back(handle);
+                });
+            }
+        }
+    }
+
+    m_windowOrigin = f - sf::Vector2i{ m_radius + 1, m_radius + 1 };
+    rebuildWindow();
+}
+
+bool ChunkWorld::collides(const sf::FloatRect& area) const {
+    const float ts = Maze::TileSize;
+    int x0 = static_cast<int>(std::floor(area.position.x / ts));
+    int y0 = static_cast<int>(std::floor(area.position.y / ts));
+    int x1 = static_cast<int>(std::floor((area.position.x + area.size.x) / ts));
+    int y1 = static_cast<int>(std::floor((area.position.y + area.size.y) / ts));
+
+    for (int ty = y0; ty <= y1; ++ty) {
+        for (int tx = x0; tx <= x1; ++tx) {
+            sf::Vector2i c = chunkOf(tx, ty);
+            bool wall;
+            if (const Chunk* chunk = find(c.x, c.y))
+                wall = (chunk->rows[ty - c.y * Chunk::Tiles] >> (tx - c.x * Chunk::Tiles)) & 1u;
+            else
+                wall = m_maze.isWall(tx, ty);
+            if (not wall) continue;
+
+            sf::FloatRect box({ tx * ts, ty * ts }, { ts, ts });
+            if (box.findIntersection(area)) return true;
+        }
+    }
+    return false;
+}
+
+bool ChunkWorld::overlappingWalls(const sf::FloatRect& area, std::pmr::vector<sf::FloatRect>& out) const {
+    const float ts = Maze::TileSize;
+    const sf::Vector2i first = chunkOf(static_cast<int>(std::floor(area.position.x / ts)), static_cast<int>(std::floor(area.position.y / ts)));
+    const sf::Vector2i last = chunkOf(static_cast<int>(std::floor((area.position.x + area.size.x) / ts)),
+                                      static_cast<int>(std::floor((area.position.y + area.size.y) / ts)));
+    // chunks outside the maze never load, there is nothing in them
+    const int maxX = (m_maze.width() - 1) / Chunk::Tiles;
+    const int maxY = (m_maze.height() - 1) / Chunk::Tiles;
+    bool complete = true;
+    for (int cy = std::max(first.y, 0); cy <= std::min(last.y, maxY); ++cy) {
+        for (int cx = std::max(first.x, 0); cx <= std::min(last.x, maxX); ++cx) {
+            const Chunk* chunk = find(cx, cy);
+            if (not chunk) {
+                complete = false;
+                continue;
+            }
+            for (const sf::IntRect& wall : chunk->walls) {
+                sf::FloatRect box({ wall.position.x * ts, wall.position.y * ts }, { wall.size.x * ts, wall.size.y * ts });
+                if (box.findIntersection(area)) out.push_back(box);
+            }
+        }
+    }
+    return complete;
+}
+
+void ChunkWorld::draw(sf::RenderTarget& target, const sf::Texture* wallTexture) const {
+    const sf::View& view = target.getView();
+    sf::FloatRect visible(view.getCenter() - view.getSize() * 0.5f, view.getSize());
+    const float chunkSize = Chunk::Tiles * Maze::TileSize;
+
+    // geometry stores normalized uvs, scale them to the texture in the render states
+    sf::RenderStates states;
+    if (wallTexture) {
+        states.texture = wallTexture;
+        states.coordinateType = sf::CoordinateType::Normalized;
+    }
+
+    for (const Chunk* chunk : m_window) {
+        if (not chunk) continue;
+        sf::FloatRect area({ chunk->coord.x * chunkSize, chunk->coord.y * chunkSize }, { chunkSize, chunkSize });
+        if (not area.findIntersection(visible)) continue;
+        target.draw(chunk->geometry, states);
+    }
+}
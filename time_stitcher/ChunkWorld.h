@@ -0,0 +1,88 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+#include "JobSystem.h"
+#include "Maze.h"
+#include "ObjectPool.h"
+
+// One square block of the maze, built off the main thread.
+struct Chunk {
+    static constexpr int Tiles = 32;
+
+    sf::Vector2i coord;                          // chunk coordinates (not tiles)
+    std::array<std::uint32_t, Tiles> rows{};     // collision: bit x of rows[y] set = wall
+    std::vector<sf::IntRect> walls;              // the wall tiles merged into rectangles (in tiles)
+    sf::VertexArray geometry{ sf::PrimitiveType::Triangles }; // one quad per wall rectangle
+};
+
+// Streams maze chunks in and out around a focus point.
+// Chunks inside `radius` are requested from the job system, finished chunks are picked up
+// at the start of the next update (a handle hand-over, nothing is built on the main thread),
+// chunks further than radius + 1 are dropped. Memory is bounded by the radius, not the maze size.
+// Chunk objects are recycled through a pool, so streaming reuses their geometry buffers.
+class ChunkWorld {
+public:
+    explicit ChunkWorld(JobSystem& jobs);
+
+    // drops everything and starts streaming the given maze
+    void reset(const Maze& maze);
+    void setRadius(int chunks);
+
+    // builds the chunk under `focus` on the calling thread (used once after reset so the player
+    // never stands in an unloaded chunk)
+    void prime(const sf::Vector2f& focus);
+    void update(const sf::Vector2f& focus);
+
+    // true if `area` overlaps a wall; tiles of chunks that are not loaded yet are asked from the maze
+    bool collides(const sf::FloatRect& area) const;
+    // wall rectangles overlapping `area`, in world units (broadphase candidates for a narrow
+    // phase); false if part of the area lies in a chunk of the maze that isn't loaded, out is
+    // incomplete then
+    bool overlappingWalls(const sf::FloatRect& area, std::pmr::vector<sf::FloatRect>& out) const;
+
+    // the wall texture has to be repeated: it tiles once per tile over the merged rectangles
+    void draw(sf::RenderTarget& target, const sf::Texture* wallTexture) const;
+
+    std::size_t loadedChunks() const;
+    std::size_t pendingChunks() const { return m_entries.size() - loadedChunks(); }
+
+private:
+    // shared with the jobs so a late job never touches a dead world; the pool itself is only
+    // used from the main thread, a job only writes the one chunk it was given
+    struct Shared {
+        ObjectPool<Chunk, 16> pool;
+        std::mutex mutex;
+        std::vector<PoolHandle> ready;
+    };
+
+    struct Entry {
+        sf::Vector2i coord;
+        PoolHandle handle;
+        bool loaded = false;
+    };
+
+    static void build(const Maze& maze, sf::Vector2i coord, Chunk& chunk);
+    static sf::Vector2i chunkOf(int tx, int ty);
+    Entry* findEntry(const sf::Vector2i& coord);
+    const Chunk* find(int cx, int cy) const;
+    void rebuildWindow();
+
+    JobSystem& m_jobs;
+    Maze m_maze;
+    int m_radius = 2;
+
+    std::shared_ptr<Shared> m_shared;
+    std::vector<Entry> m_entries;        // at most (2 * radius + 3)^2
+    std::vector<PoolHandle> m_orphans;   // still building for a previous maze
+    std::vector<PoolHandle> m_arrived;   // swapped with Shared::ready
+
+    // loaded chunks around the focus, for O(1) lookups
+    std::vector<const Chunk*> m_window;
+    sf::Vector2i m_windowOrigin;
+    int m_windowSize = 0;
+};
@@ -0,0 +1,77 @@
+#include "CollisionMask.h"
+#include <algorithm>
+#include <cmath>
+
+CollisionMask CollisionMask::fromImage(const sf::Image& image, const sf::IntRect& rect, float scale, std::uint8_t threshold) {
+    CollisionMask mask;
+    mask.m_width = static_cast<int>(std::lround(rect.size.x * scale));
+    mask.m_height = static_cast<int>(std::lround(rect.size.y * scale));
+    if (mask.m_width <= 0 or mask.m_height <= 0) return mask;
+    mask.m_wordsPerRow = (mask.m_width + 63) / 64;
+    mask.m_rows.assign(static_cast<std::size_t>(mask.m_wordsPerRow) * mask.m_height, 0);
+
+    const sf::Vector2u imageSize = image.getSize();
+    int minX = mask.m_width, minY = mask.m_height, maxX = -1, maxY = -1;
+    for (int y = 0; y < mask.m_height; ++y) {
+        const int ty = rect.position.y + std::min(static_cast<int>(y / scale), rect.size.y - 1);
+        for (int x = 0; x < mask.m_width; ++x) {
+            const int tx = rect.position.x + std::min(static_cast<int>(x / scale), rect.size.x - 1);
+            if (tx < 0 or ty < 0 or tx >= static_cast<int>(imageSize.x) or ty >= static_cast<int>(imageSize.y)) continue;
+            if (image.getPixel({ static_cast<unsigned>(tx), static_cast<unsigned>(ty) }).a < threshold) continue;
+            mask.m_rows[y * mask.m_wordsPerRow + (x >> 6)] |= std::uint64_t{ 1 } << (x & 63);
+            minX = std::min(minX, x);
+            maxX = std::max(maxX, x);
+            minY = std::min(minY, y);
+            maxY = std::max(maxY, y);
+        }
+    }
+    if (maxX >= 0) mask.m_opaque = sf::IntRect({ minX, minY }, { maxX - minX + 1, maxY - minY + 1 });
+    return mask;
+}
+
+namespace {
+    // overlap of the solid parts in world pixels; false if there is none
+    bool intersect(const sf::IntRect& a, const sf::IntRect& b, sf::IntRect& out) {
+        auto found = a.findIntersection(b);
+        if (not found) return false;
+        out = *found;
+        return true;
+    }
+
+    sf::IntRect placed(const CollisionMask& mask, sf::Vector2i topLeft) {
+        return { mask.opaqueBounds().position + topLeft, mask.opaqueBounds().size };
+    }
+
+    // the first `count` columns of a 64 column chunk
+    std::uint64_t firstColumns(int count) {
+        return count >= 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << count) - 1;
+    }
+}
+
+bool collision::overlaps(const CollisionMask& a, sf::Vector2i aTopLeft, const CollisionMask& b, sf::Vector2i bTopLeft) {
+    sf::IntRect area;
+    if (a.empty() or b.empty() or not intersect(placed(a, aTopLeft), placed(b, bTopLeft), area)) return false;
+
+    const int right = area.position.x + area.size.x;
+    for (int y = area.position.y; y < area.position.y + area.size.y; ++y) {
+        const int ya = y - aTopLeft.y, yb = y - bTopLeft.y;
+        for (int x = area.position.x; x < right; x += 64) {
+            const std::uint64_t both = a.bits(ya, x - aTopLeft.x) & b.bits(yb, x - bTopLeft.x);
+            if (both & firstColumns(right - x)) return true;
+        }
+    }
+    return false;
+}
+
+bool collision::overlaps(const CollisionMask& a, sf::Vector2i aTopLeft, const sf::IntRect& solid) {
+    sf::IntRect area;
+    if (a.empty() or not intersect(placed(a, aTopLeft), solid, area)) return false;
+
+    const int right = area.position.x + area.size.x;
+    for (int y = area.position.y; y < area.position.y + area.size.y; ++y) {
+        const int ya = y - aTopLeft.y;
+        for (int x = area.position.x; x < right; x += 64)
+            if (a.bits(ya, x - aTopLeft.x) & firstColumns(right - x)) return true;
+    }
+    return false;
+}
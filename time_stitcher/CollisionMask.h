@@ -0,0 +1,52 @@
+#pragma once
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <cstdint>
+#include <vector>
+
+// 1 bit per pixel: solid where the alpha of the image is at least the threshold. Built once at
+// load time, in world pixels (a texel scaled up by the sprite scale covers scale x scale bits),
+// so two masks are compared by shifting rows against each other: 64 columns per AND.
+// Bit i of word w of a row is column w * 64 + i.
+class CollisionMask {
+public:
+    // scale: world pixels per texel (nearest sampling)
+    static CollisionMask fromImage(const sf::Image& image, const sf::IntRect& rect, float scale = 1.f, std::uint8_t threshold = 128);
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    bool empty() const { return m_opaque.size.x == 0; }
+    // smallest rectangle holding every solid pixel, in mask pixels
+    const sf::IntRect& opaqueBounds() const { return m_opaque; }
+
+    bool test(int x, int y) const {
+        if (x < 0 or y < 0 or x >= m_width or y >= m_height) return false;
+        return (m_rows[y * m_wordsPerRow + (x >> 6)] >> (x & 63)) & 1u;
+    }
+
+    // the 64 columns starting at x of row y (x may be negative or past the end: missing columns are 0)
+    std::uint64_t bits(int y, int x) const {
+        const std::uint64_t* row = &m_rows[y * m_wordsPerRow];
+        if (x <= -64 or x >= m_width) return 0;
+        if (x < 0) return row[0] << -x;
+        const int word = x >> 6, shift = x & 63;
+        std::uint64_t out = row[word] >> shift;
+        if (shift != 0 and word + 1 < m_wordsPerRow) out |= row[word + 1] << (64 - shift);
+        return out;
+    }
+
+private:
+    int m_width = 0;
+    int m_height = 0;
+    int m_wordsPerRow = 0;
+    std::vector<std::uint64_t> m_rows;
+    sf::IntRect m_opaque;
+};
+
+// Narrow phase, for pairs whose boxes already overlap. Positions are the world pixel of the
+// masks' (0, 0); unrotated sprites only.
+namespace collision {
+    bool overlaps(const CollisionMask& a, sf::Vector2i aTopLeft, const CollisionMask& b, sf::Vector2i bTopLeft);
+    // mask against a fully solid rectangle (untextured obstacles, walls)
+    bool overlaps(const CollisionMask& a, sf::Vector2i aTopLeft, const sf::IntRect& solid);
+}
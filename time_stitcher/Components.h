@@ -0,0 +1,44 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+
+// Plain data components for the Registry (see Ecs.h). Obstacle is used as a component as is.
+
+struct Position {
+    sf::Vector2f value;
+};
+
+struct Velocity {
+    sf::Vector2f value;
+};
+
+// axis aligned box centered on Position
+struct Collider {
+    sf::Vector2f halfSize;
+};
+
+// instance index in an AnimationBatch
+struct Animated {
+    std::uint32_t slot = 0;
+};
+
+// index of the entity's state in the timeline's ObstacleStore
+struct TimelineSlot {
+    std::uint32_t index = 0;
+};
+
+// proxy of the entity's box in an AabbTree (the obstacle broadphase)
+struct TreeProxy {
+    int id = -1;
+};
+
+// follows the flow field towards the player ("time echo")
+struct Chaser {
+    float speed = 120.f;
+    int contacts = 0; // other movers its box overlaps (systems::collideMovers)
+};
+
+// box of a mover in the SweepAndPrune of the movers
+struct SweepProxy {
+    std::uint32_t id = 0;
+};
@@ -0,0 +1,228 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Minimal sparse-set entity-component-system.
+// Every component type lives in its own pool: a dense array of components plus a dense array
+// of owning entities (iterated linearly), and a sparse entity-index -> dense-slot table.
+// Removing swaps the last element into the hole, so pools stay packed.
+// Structural changes (create/destroy/emplace/remove) must not happen while iterating the pools
+// they touch; queue them with defer()/deferDestroy() and apply them with flush().
+
+// low 20 bits: index, high 12 bits: generation (detects stale handles after reuse)
+using Entity = std::uint32_t;
+constexpr Entity NullEntity = 0xFFFFFFFFu;
+
+namespace ecs {
+    constexpr std::uint32_t IndexBits = 20;
+    constexpr std::uint32_t IndexMask = (1u << IndexBits) - 1;
+    constexpr std::uint32_t NoSlot = 0xFFFFFFFFu;
+
+    inline std::uint32_t index(Entity e) { return e & IndexMask; }
+    inline std::uint32_t generation(Entity e) { return e >> IndexBits; }
+
+    inline std::size_t nextTypeId() {
+        static std::size_t counter = 0;
+        return counter++;
+    }
+    template <class T>
+    std::size_t typeId() {
+        static const std::size_t id = nextTypeId();
+        return id;
+    }
+
+    class PoolBase {
+    public:
+        virtual ~PoolBase() = default;
+        virtual void remove(Entity e) = 0;
+        virtual void clear() = 0;
+        virtual bool contains(Entity e) const = 0;
+    };
+
+    template <class T>
+    class Pool final : public PoolBase {
+    public:
+        bool contains(Entity e) const override {
+            std::uint32_t i = index(e);
+            return i < m_sparse.size() and m_sparse[i] != NoSlot and m_entities[m_sparse[i]] == e;
+        }
+
+        template <class... Args>
+        T& emplace(Entity e, Args&&... args) {
+            std::uint32_t i = index(e);
+            if (i >= m_sparse.size()) m_sparse.resize(i + 1, NoSlot);
+            assert(m_sparse[i] == NoSlot);
+            m_sparse[i] = static_cast<std::uint32_t>(m_dense.size());
+            m_entities.push_back(e);
+            m_dense.emplace_back(std::forward<Args>(args)...);
+            return m_dense.back();
+        }
+
+        void remove(Entity e) override {
+            if (not contains(e)) return;
+            std::uint32_t slot = m_sparse[index(e)];
+            std::uint32_t last = static_cast<std::uint32_t>(m_dense.size() - 1);
+            if (slot != last) {
+                m_dense[slot] = std::move(m_dense[last]);
+                m_entities[slot] = m_entities[last];
+                m_sparse[index(m_entities[slot])] = slot;
+            }
+            m_dense.pop_back();
+            m_entities.pop_back();
+            m_sparse[index(e)] = NoSlot;
+        }
+
+        void clear() override {
+            m_dense.clear();
+            m_entities.clear();
+            m_sparse.clear();
+        }
+
+        void reserve(std::size_t n) {
+            m_dense.reserve(n);
+            m_entities.reserve(n);
+            if (m_sparse.size() < n) m_sparse.resize(n, NoSlot);
+        }
+
+        T& get(Entity e) { return m_dense[m_sparse[index(e)]]; }
+        T* tryGet(Entity e) { return contains(e) ? &get(e) : nullptr; }
+
+        std::size_t size() const { return m_dense.size(); }
+        const std::vector<Entity>& entities() const { return m_entities; }
+        std::vector<T>& components() { return m_dense; }
+
+    private:
+        std::vector<T> m_dense;
+        std::vector<Entity> m_entities;
+        std::vector<std::uint32_t> m_sparse;
+    };
+}
+
+class Registry {
+public:
+    Entity create() {
+        std::uint32_t i;
+        if (not m_free.empty()) {
+            i = m_free.back();
+            m_free.pop_back();
+        }
+        else {
+            i = static_cast<std::uint32_t>(m_generations.size());
+            assert(i <= ecs::IndexMask);
+            m_generations.push_back(0);
+        }
+        ++m_alive;
+        return (m_generations[i] << ecs::IndexBits) | i;
+    }
+
+    void destroy(Entity e) {
+        if (not valid(e)) return;
+        for (auto& pool : m_pools)
+            if (pool) pool->remove(e);
+        std::uint32_t i = ecs::index(e);
+        m_generations[i] = (m_generations[i] + 1) & (ecs::NoSlot >> ecs::IndexBits);
+        m_free.push_back(i);
+        --m_alive;
+    }
+
+    bool valid(Entity e) const {
+        std::uint32_t i = ecs::index(e);
+        return e != NullEntity and i < m_generations.size() and m_generations[i] == ecs::generation(e);
+    }
+
+    // destroys every entity; pools keep their capacity
+    void clear() {
+        for (auto& pool : m_pools)
+            if (pool) pool->clear();
+        m_free.clear();
+        for (std::uint32_t i = static_cast<std::uint32_t>(m_generations.size()); i-- > 0;) {
+            m_generations[i] = (m_generations[i] + 1) & (ecs::NoSlot >> ecs::IndexBits);
+            m_free.push_back(i);
+        }
+        m_alive = 0;
+        m_deferred.clear();
+    }
+
+    std::size_t alive() const { return m_alive; }
+
+    template <class T, class... Args>
+    T& emplace(Entity e, Args&&... args) {
+        return pool<T>().emplace(e, std::forward<Args>(args)...);
+    }
+
+    template <class T>
+    void remove(Entity e) { pool<T>().remove(e); }
+
+    // pre-sizes entity slots and the listed pools so spawning up to n entities never allocates
+    template <class... Ts>
+    void reserve(std::size_t n) {
+        m_generations.reserve(n);
+        m_free.reserve(n);
+        (pool<Ts>().reserve(n), ...);
+    }
+
+    template <class T>
+    bool has(Entity e) const {
+        std::size_t id = ecs::typeId<T>();
+        return id < m_pools.size() and m_pools[id] and m_pools[id]->contains(e);
+    }
+
+    template <class T>
+    T& get(Entity e) { return pool<T>().get(e); }
+
+    template <class T>
+    T* tryGet(Entity e) { return pool<T>().tryGet(e); }
+
+    template <class T>
+    ecs::Pool<T>& pool() {
+        std::size_t id = ecs::typeId<T>();
+        if (id >= m_pools.size()) m_pools.resize(id + 1);
+        if (not m_pools[id]) m_pools[id] = std::make_unique<ecs::Pool<T>>();
+        return static_cast<ecs::Pool<T>&>(*m_pools[id]);
+    }
+
+    // calls fn(entity, First&, Rest&...) for every entity owning all listed components.
+    // Walks the dense array of First linearly; put the rarest component first.
+    template <class First, class... Rest, class Fn>
+    void each(Fn&& fn) {
+        auto& first = pool<First>();
+        auto others = std::tuple<ecs::Pool<Rest>&...>(pool<Rest>()...);
+        const auto& entities = first.entities();
+        auto& components = first.components();
+        for (std::size_t i = 0; i < entities.size(); ++i) {
+            Entity e = entities[i];
+            if constexpr (sizeof...(Rest) == 0) {
+                fn(e, components[i]);
+            }
+            else {
+                bool all = std::apply([e](auto&... p) { return (p.contains(e) and ...); }, others);
+                if (all) std::apply([&](auto&... p) { fn(e, components[i], p.get(e)...); }, others);
+            }
+        }
+    }
+
+    // deferred structural changes, applied in order by flush()
+    void defer(std::function<void(Registry&)> change) { m_deferred.push_back(std::move(change)); }
+    void deferDestroy(Entity e) { m_deferred.push_back([e](Registry& r) { r.destroy(e); }); }
+    void flush() {
+        // changes may queue further changes, run until nothing is left
+        while (not m_deferred.empty()) {
+            m_flushing.swap(m_deferred);
+            for (auto& change : m_flushing) change(*this);
+            m_flushing.clear();
+        }
+    }
+
+private:
+    std::vector<std::unique_ptr<ecs::PoolBase>> m_pools;
+    std::vector<std::uint32_t> m_generations;
+    std::vector<std::uint32_t> m_free;
+    std::size_t m_alive = 0;
+    std::vector<std::function<void(Registry&)>> m_deferred;
+    std::vector<std::function<void(Registry&)>> m_flushing;
+};
@@ -0,0 +1,150 @@
+#include "FlowField.h"
+#include "MemoryTracker.h"
+#include <algorithm>
+
+namespace {
+    // 8 neighbour offsets, index = value stored in the direction field
+    constexpr int Dx[8] = { 1, -1, 0, 0, 1, -1, 1, -1 };
+    constexpr int Dy[8] = { 0, 0, 1, -1, 1, 1, -1, -1 };
+}
+
+FlowField::FlowField(JobSystem& jobs, int maxSteps)
+    : m_jobs(jobs), m_maxSteps(maxSteps)
+{
+}
+
+void FlowField::reset(const TileGrid& grid) {
+    // a job still running on the old state keeps it alive and finishes into nothing
+    m_state = std::make_shared<State>();
+    m_state->grid = grid;
+    m_state->maxSteps = m_maxSteps;
+    m_front = nullptr;
+    m_requested = { -1, -1 };
+}
+
+void FlowField::compute(const TileGrid& grid, Field& field, const sf::Vector2i& target, int maxSteps) {
+    const int w = grid.width();
+    const std::size_t n = static_cast<std::size_t>(w) * grid.height();
+    if (field.stamp.size() != n) {
+        field.stamp.assign(n, 0);
+        field.cost.assign(n, 0);
+        field.dir.assign(n, NoDirection);
+        field.queue.reserve(n);
+        field.generation = 0;
+    }
+    if (++field.generation == 0) {
+        std::fill(field.stamp.begin(), field.stamp.end(), 0);
+        field.generation = 1;
+    }
+    const std::uint32_t gen = field.generation;
+    field.target = target;
+    field.queue.clear();
+    if (grid.blocked(target.x, target.y)) return;
+
+    // 1) integration field: 4-connected BFS from the target
+    int start = target.y * w + target.x;
+    field.stamp[start] = gen;
+    field.cost[start] = 0;
+    field.dir[start] = NoDirection;
+    field.queue.push_back(start);
+    for (std::size_t head = 0; head < field.queue.size(); ++head) {
+        int node = field.queue[head];
+        std::uint32_t next = field.cost[node] + 1;
+        if (next > static_cast<std::uint32_t>(maxSteps)) continue;
+        int x = node % w, y = node / w;
+        for (int d = 0; d < 4; ++d) {
+            int nx = x + Dx[d], ny = y + Dy[d];
+            if (grid.blocked(nx, ny)) continue;
+            int ni = ny * w + nx;
+            if (field.stamp[ni] == gen) continue;
+            field.stamp[ni] = gen;
+            field.cost[ni] = next;
+            field.queue.push_back(ni);
+        }
+    }
+
+    // 2) direction field: cheapest reached neighbour, diagonals only past free corners
+    for (std::size_t i = 1; i < field.queue.size(); ++i) {
+        int node = field.queue[i];
+        int x = node % w, y = node / w;
+        std::uint32_t best = field.cost[node];
+        std::uint8_t bestDir = NoDirection;
+        for (int d = 0; d < 8; ++d) {
+            int nx = x + Dx[d], ny = y + Dy[d];
+            if (grid.blocked(nx, ny)) continue;
+            if (d >= 4 and (grid.blocked(nx, y) or grid.blocked(x, ny))) continue;
+            int ni = ny * w + nx;
+            if (field.stamp[ni] != gen) continue;
+            if (field.cost[ni] < best) {
+                best = field.cost[ni];
+                bestDir = static_cast<std::uint8_t>(d);
+            }
+        }
+        field.dir[node] = bestDir;
+    }
+}
+
+void FlowField::run(State& state, const sf::Vector2i& target, std::uint32_t serial) {
+    std::uint32_t expected = tagged(serial, Queued);
+    if (not state.stage.compare_exchange_strong(expected, tagged(serial, Running), std::memory_order_acquire)) return;
+    memory::Scope tag(memory::Tag::Simulation);
+    compute(state.grid, state.buffers[state.back], target, state.maxSteps);
+    state.stage.store(tagged(serial, Finished), std::memory_order_release);
+    state.stage.notify_one();
+}
+
+void FlowField::update(const sf::Vector2i& target) {
+    if (not m_state) return;
+    State& state = *m_state;
+
+    if ((state.stage.load(std::memory_order_relaxed) & 3) != Idle) {
+        // results are published a fixed number of updates after the request, however fast the
+        // worker was, so a deterministic simulation sees the same field on the same tick
+        if (++m_updatesInFlight < PublishDelay) return;
+        // still queued behind other jobs: compute it here rather than wait for a free worker
+        run(state, m_requested, state.serial);
+        for (std::uint32_t stage; ((stage = state.stage.load(std::memory_order_acquire)) & 3) != Finished;)
+            state.stage.wait(stage, std::memory_order_acquire);
+        m_front = &state.buffers[state.back];
+        state.back = 1 - state.back;
+        state.stage.store(Idle, std::memory_order_relaxed);
+    }
+
+    // at most one recompute in flight; a newer target is picked up once it lands
+    if (target == m_requested) return;
+    m_requested = target;
+    m_updatesInFlight = 0;
+    const std::uint32_t serial = ++state.serial;
+    state.stage.store(tagged(serial, Queued), std::memory_order_relaxed);
+
+    std::shared_ptr<State> shared = m_state;
+    m_jobs.submitUrgent([shared, target, serial] { run(*shared, target, serial); });
+}
+
+int FlowField::index(const sf::Vector2i& tile) const {
+    if (not m_front or not m_state->grid.inside(tile.x, tile.y)) return -1;
+    int i = tile.y * m_state->grid.width() + tile.x;
+    return m_front->stamp[i] == m_front->generation ? i : -1;
+}
+
+std::uint8_t FlowField::directionIndex(const sf::Vector2i& tile) const {
+    int i = index(tile);
+    return i < 0 ? NoDirection : m_front->dir[i];
+}
+
+sf::Vector2i FlowField::step(const sf::Vector2i& tile) const {
+    std::uint8_t d = directionIndex(tile);
+    if (d == NoDirection) return { 0, 0 };
+    return { Dx[d], Dy[d] };
+}
+
+sf::Vector2f FlowField::direction(const sf::Vector2i& tile) const {
+    sf::Vector2i s = step(tile);
+    if (s.x != 0 and s.y != 0) return { s.x * 0.70710678f, s.y * 0.70710678f };
+    return { static_cast<float>(s.x), static_cast<float>(s.y) };
+}
+
+int FlowField::distance(const sf::Vector2i& tile) const {
+    int i = index(tile);
+    return i < 0 ? -1 : static_cast<int>(m_front->cost[i]);
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "JobSystem.h"
+#include "TileGrid.h"
+
+// Shared navigation field towards one target tile (the player).
+// A BFS integration field is grown outward from the target (up to maxSteps), then every reached
+// tile stores the direction to its cheapest neighbour. Any number of agents can then follow
+// the field with one array lookup per agent.
+// Recomputes run on the job system (ahead of queued chunk jobs) into a back buffer; update()
+// swaps it in PublishDelay updates after the request, so sampling stays deterministic. A job
+// that hasn't started by then is run by update() itself; one that is running is waited for.
+class FlowField {
+public:
+    static constexpr std::uint8_t NoDirection = 0xFF;
+    static constexpr int PublishDelay = 4; // updates between a request and its result
+
+    explicit FlowField(JobSystem& jobs, int maxSteps = 512);
+
+    // copies the grid; call again whenever the maze changes
+    void reset(const TileGrid& grid);
+
+    // requests a recompute if `target` moved to another tile and publishes finished results
+    void update(const sf::Vector2i& target);
+
+    // neighbour index 0..7 or NoDirection (target itself, walls, out of reach)
+    std::uint8_t directionIndex(const sf::Vector2i& tile) const;
+    // unit step towards the target, {0, 0} if there is none
+    sf::Vector2i step(const sf::Vector2i& tile) const;
+    sf::Vector2f direction(const sf::Vector2i& tile) const;
+
+    // steps from tile to target, -1 if not reached
+    int distance(const sf::Vector2i& tile) const;
+
+    bool ready() const { return m_front != nullptr; }
+    sf::Vector2i target() const { return m_front ? m_front->target : sf::Vector2i{ -1, -1 }; }
+
+private:
+    struct Field {
+        sf::Vector2i target{ -1, -1 };
+        std::uint32_t generation = 0;
+        std::vector<std::uint32_t> stamp;   // == generation: tile reached in this field
+        std::vector<std::uint32_t> cost;
+        std::vector<std::uint8_t> dir;
+        std::vector<std::int32_t> queue;    // BFS queue, also the list of reached tiles
+    };
+
+    // stage of the latest request in the low bits, its serial above: a job left in the queue
+    // for a request that was computed inline can't claim the next request
+    enum Stage : std::uint32_t { Idle, Queued, Running, Finished };
+    static std::uint32_t tagged(std::uint32_t serial, Stage stage) { return serial << 2 | stage; }
+
+    struct State {
+        TileGrid grid;
+        int maxSteps = 0;
+        Field buffers[2];
+        std::atomic<std::uint32_t> stage{ Idle };
+        std::uint32_t serial = 0; // of the latest request
+        int back = 1;
+    };
+
+    static void compute(const TileGrid& grid, Field& field, const sf::Vector2i& target, int maxSteps);
+    // computes request `serial` into the back buffer unless someone else already claimed it
+    static void run(State& state, const sf::Vector2i& target, std::uint32_t serial);
+    int index(const sf::Vector2i& tile) const;
+
+    JobSystem& m_jobs;
+    int m_maxSteps;
+    std::shared_ptr<State> m_state;
+    const Field* m_front = nullptr;
+    sf::Vector2i m_requested{ -1, -1 };
+    int m_updatesInFlight = 0;
+};
@@ -0,0 +1,166 @@
+#include "FogOfWar.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include "MemoryTracker.h"
+
+namespace {
+    // alpha of the fog
+    constexpr std::uint8_t Unexplored = 255;
+    constexpr std::uint8_t Remembered = 160;
+    constexpr std::uint8_t Visible = 0;
+
+    int floorDiv(int a, int b) { return a / b - ((a % b != 0) and ((a < 0) != (b < 0))); }
+    int ceilDiv(int a, int b) { return -floorDiv(-a, b); }
+
+    sf::IntRect unite(const sf::IntRect& a, const sf::IntRect& b) {
+        if (a.size.x <= 0 or a.size.y <= 0) return b;
+        if (b.size.x <= 0 or b.size.y <= 0) return a;
+        const sf::Vector2i lo(std::min(a.position.x, b.position.x), std::min(a.position.y, b.position.y));
+        const sf::Vector2i hi(std::max(a.position.x + a.size.x, b.position.x + b.size.x),
+                              std::max(a.position.y + a.size.y, b.position.y + b.size.y));
+        return { lo, hi - lo };
+    }
+}
+
+void FogOfWar::reset(const TileGrid& grid, float tileSize) {
+    m_grid = &grid;
+    m_words = grid.wordsPerRow();
+    const std::size_t words = static_cast<std::size_t>(m_words) * grid.height();
+    m_visible.assign(words, 0);
+    m_explored.assign(words, 0);
+    m_hasOrigin = false;
+    m_sprite.reset();
+    m_dirty = {};
+
+    const sf::Vector2u size(static_cast<unsigned>(grid.width()), static_cast<unsigned>(grid.height()));
+    if (not m_texture) m_texture.emplace();
+    if (grid.empty() or not m_texture->resize(size)) {
+        std::cerr << "No fog texture for a " << size.x << "x" << size.y << " maze, the fog is off\n";
+        m_texture.reset();
+        return;
+    }
+    // texel centres sit on tile centres, smoothing gives soft edges for free
+    m_texture->setSmooth(true);
+    m_sprite.emplace(*m_texture);
+    m_sprite->setScale({ tileSize, tileSize });
+    m_dirty = { { 0, 0 }, sf::Vector2i(size) };
+}
+
+void FogOfWar::setRadius(int radius) {
+    m_radius = radius;
+    m_reach.resize(static_cast<std::size_t>(radius) + 1);
+    for (int depth = 0; depth <= radius; ++depth)
+        m_reach[depth] = static_cast<int>(std::sqrt(static_cast<float>(radius * radius + radius - depth * depth)));
+    m_hasOrigin = false; // next update recomputes
+}
+
+sf::IntRect FogOfWar::around(sf::Vector2i origin) const {
+    const sf::Vector2i lo(std::max(origin.x - m_radius, 0), std::max(origin.y - m_radius, 0));
+    const sf::Vector2i hi(std::min(origin.x + m_radius + 1, m_grid->width()), std::min(origin.y + m_radius + 1, m_grid->height()));
+    if (hi.x <= lo.x or hi.y <= lo.y) return {};
+    return { lo, hi - lo };
+}
+
+void FogOfWar::markDirty(const sf::IntRect& area) {
+    m_dirty = unite(m_dirty, area);
+}
+
+void FogOfWar::clearVisible(const sf::IntRect& area) {
+    // whole words at a time, masked at both ends
+    const int first = area.position.x, last = area.position.x + area.size.x - 1;
+    for (int y = area.position.y; y < area.position.y + area.size.y; ++y) {
+        std::uint64_t* row = m_visible.data() + static_cast<std::size_t>(y) * m_words;
+        for (int w = first >> 6; w <= last >> 6; ++w) {
+            const int lo = std::max(first - w * 64, 0), hi = std::min(last - w * 64, 63);
+            const std::uint64_t mask = (~std::uint64_t{ 0 } >> (63 - hi)) & (~std::uint64_t{ 0 } << lo);
+            row[w] &= ~mask;
+        }
+    }
+}
+
+void FogOfWar::reveal(int x, int y) {
+    if (not m_grid->inside(x, y)) return;
+    const int dx = x - m_origin.x, dy = y - m_origin.y;
+    if (dx * dx + dy * dy > m_radius * m_radius + m_radius) return; // a disc, not a square
+    const std::size_t word = static_cast<std::size_t>(y) * m_words + (x >> 6);
+    const std::uint64_t bit = std::uint64_t{ 1 } << (x & 63);
+    m_visible[word] |= bit;
+    m_explored[word] |= bit;
+}
+
+sf::Vector2i FogOfWar::transform(int quadrant, int depth, int col) const {
+    switch (quadrant) {
+    case 0: return { m_origin.x + col, m_origin.y - depth }; // north
+    case 1: return { m_origin.x + depth, m_origin.y + col }; // east
+    case 2: return { m_origin.x + col, m_origin.y + depth }; // south
+    default: return { m_origin.x - depth, m_origin.y + col }; // west
+    }
+}
+
+void FogOfWar::scan(int quadrant, int depth, Slope start, Slope end) {
+    if (depth > m_radius) return;
+    // columns whose centre lies within [start, end] rounded outwards, ties towards the row
+    // and never further out than the disc: what lies beyond only shadows tiles further out
+    const int reach = m_reach[depth] + 1;
+    const int minCol = std::max(floorDiv(2 * depth * start.num + start.den, 2 * start.den), -reach);
+    const int maxCol = std::min(ceilDiv(2 * depth * end.num - end.den, 2 * end.den), reach);
+    int prev = -1; // -1: none yet, 0: floor, 1: wall
+    for (int col = minCol; col <= maxCol; ++col) {
+        const sf::Vector2i tile = transform(quadrant, depth, col);
+        const int wall = m_grid->blocked(tile.x, tile.y) ? 1 : 0;
+        // walls show when any part is lit, floors only when their centre is (the symmetric part)
+        const bool symmetric = col * start.den >= depth * start.num and col * end.den <= depth * end.num;
+        if (wall or symmetric) reveal(tile.x, tile.y);
+        const Slope edge{ 2 * col - 1, 2 * depth };
+        if (prev == 1 and not wall) start = edge;
+        if (prev == 0 and wall) scan(quadrant, depth + 1, start, edge);
+        prev = wall;
+    }
+    if (prev == 0) scan(quadrant, depth + 1, start, end);
+}
+
+bool FogOfWar::update(sf::Vector2i origin) {
+    if (not m_grid or (m_hasOrigin and origin == m_origin)) return false;
+    if (m_hasOrigin) {
+        const sf::IntRect old = around(m_origin);
+        clearVisible(old);
+        markDirty(old);
+    }
+    m_origin = origin;
+    m_hasOrigin = true;
+    if (not m_grid->inside(origin.x, origin.y)) return true;
+
+    const std::size_t word = static_cast<std::size_t>(origin.y) * m_words + (origin.x >> 6);
+    m_visible[word] |= std::uint64_t{ 1 } << (origin.x & 63);
+    m_explored[word] |= std::uint64_t{ 1 } << (origin.x & 63);
+    for (int quadrant = 0; quadrant < 4; ++quadrant) scan(quadrant, 1, { -1, 1 }, { 1, 1 });
+    markDirty(around(origin));
+    return true;
+}
+
+void FogOfWar::upload() {
+    const sf::IntRect r = m_dirty;
+    m_dirty = {};
+    if (r.size.x <= 0 or r.size.y <= 0) return;
+    m_pixels.resize(static_cast<std::size_t>(r.size.x) * r.size.y * 4);
+    std::uint8_t* out = m_pixels.data();
+    for (int y = r.position.y; y < r.position.y + r.size.y; ++y) {
+        for (int x = r.position.x; x < r.position.x + r.size.x; ++x) {
+            out[0] = out[1] = out[2] = 0;
+            out[3] = visible(x, y) ? Visible : explored(x, y) ? Remembered : Unexplored;
+            out += 4;
+        }
+    }
+    m_texture->update(m_pixels.data(), sf::Vector2u(r.size), sf::Vector2u(r.position));
+}
+
+void FogOfWar::draw(sf::RenderTarget& target) {
+    if (not m_sprite) return;
+    upload();
+    target.draw(*m_sprite);
+}
+
+std::size_t FogOfWar::textureBytes() const {
+    return m_texture ? memory::textureBytes(*m_texture) : 0;
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "TileGrid.h"
+
+// What the player can see of the maze. Visibility is computed on the tile grid with symmetric
+// shadowcasting (Albert Ford's variant: a floor tile is visible only if its centre is, so A
+// sees B exactly when B sees A, and there are no gaps along walls) and kept as two bitsets:
+// visible now and explored at some point. It is only recomputed when the origin enters another
+// tile. The fog is one texture with a texel per tile, stretched over the maze with smooth
+// filtering; a recompute only uploads the rectangle around the old and the new origin.
+class FogOfWar {
+public:
+    explicit FogOfWar(int radius = 10) { setRadius(radius); }
+
+    // the grid is referenced and must outlive the fog; everything starts unexplored
+    void reset(const TileGrid& grid, float tileSize);
+    void setRadius(int radius);
+
+    // recomputes if `origin` is another tile than last time; true if it did
+    bool update(sf::Vector2i origin);
+
+    bool visible(int x, int y) const { return test(m_visible, x, y); }
+    bool explored(int x, int y) const { return test(m_explored, x, y); }
+
+    // uploads what changed since the last draw, then draws the fog in one call
+    void draw(sf::RenderTarget& target);
+
+    std::size_t textureBytes() const;
+
+private:
+    struct Slope {
+        int num, den; // den > 0
+    };
+
+    bool test(const std::vector<std::uint64_t>& bits, int x, int y) const {
+        if (not m_grid or not m_grid->inside(x, y)) return false;
+        return (bits[static_cast<std::size_t>(y) * m_words + (x >> 6)] >> (x & 63)) & 1u;
+    }
+    void reveal(int x, int y);
+    // one row of one quadrant, then the rows behind its open stretches
+    void scan(int quadrant, int depth, Slope start, Slope end);
+    sf::Vector2i transform(int quadrant, int depth, int col) const;
+    void clearVisible(const sf::IntRect& area);
+    sf::IntRect around(sf::Vector2i origin) const;
+    void markDirty(const sf::IntRect& area);
+    void upload();
+
+    const TileGrid* m_grid = nullptr;
+    int m_radius = 0;
+    std::vector<int> m_reach; // per row depth: the last column inside the disc
+    int m_words = 0;
+    std::vector<std::uint64_t> m_visible;
+    std::vector<std::uint64_t> m_explored;
+    sf::Vector2i m_origin{ -1, -1 };
+    bool m_hasOrigin = false;
+
+    std::optional<sf::Texture> m_texture;
+    std::optional<sf::Sprite> m_sprite;
+    std::vector<std::uint8_t> m_pixels; // staging for the dirty rectangle
+    sf::IntRect m_dirty;                // empty: nothing to upload
+};
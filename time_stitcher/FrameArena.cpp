@@ -0,0 +1,66 @@
+#include "FrameArena.h"
+#include <cstdint>
+#include <cstring>
+
+namespace {
+#ifdef _DEBUG
+    constexpr unsigned char PoisonByte = 0xDD;
+#endif
+}
+
+FrameArena::FrameArena(std::size_t capacity, std::pmr::memory_resource* upstream)
+    : m_upstream(upstream), m_buffer(new std::byte[capacity]), m_capacity(capacity)
+{
+    m_overflow.reserve(16);
+}
+
+FrameArena::~FrameArena() {
+    for (const Block& block : m_overflow)
+        m_upstream->deallocate(block.ptr, block.bytes, block.alignment);
+}
+
+void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_buffer.get());
+    std::uintptr_t aligned = (base + m_offset + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    std::size_t end = static_cast<std::size_t>(aligned - base) + bytes;
+    if (end <= m_capacity) {
+        m_offset = end;
+        if (used() > m_highWater) m_highWater = used();
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    // out of space: serve from upstream for the rest of the frame
+    void* p = m_upstream->allocate(bytes, alignment);
+    m_overflow.push_back({ p, bytes, alignment });
+    m_overflowBytes += bytes;
+    ++m_overflowCount;
+    if (used() > m_highWater) m_highWater = used();
+    return p;
+}
+
+void FrameArena::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    (void)alignment;
+#ifdef _DEBUG
+    std::memset(p, PoisonByte, bytes);
+#else
+    (void)p;
+    (void)bytes;
+#endif
+}
+
+void FrameArena::reset() {
+#ifdef _DEBUG
+    std::memset(m_buffer.get(), PoisonByte, m_offset);
+#endif
+    for (const Block& block : m_overflow)
+        m_upstream->deallocate(block.ptr, block.bytes, block.alignment);
+
+    // grow once to what the busiest frame needed (+ alignment slack)
+    if (not m_overflow.empty() and m_highWater > m_capacity) {
+        m_capacity = m_highWater + m_highWater / 4;
+        m_buffer.reset(new std::byte[m_capacity]);
+    }
+    m_overflow.clear();
+    m_overflowBytes = 0;
+    m_offset = 0;
+}
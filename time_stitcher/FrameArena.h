@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+// Linear (bump) allocator for data that only lives for one frame.
+// Exposed as a std::pmr::memory_resource, so standard containers can use it:
+//     std::pmr::vector<Entity> hits(&frameArena);
+// deallocate() is a no-op, everything is released at once by reset() at the end of the frame.
+// If a frame needs more than the capacity, the rest comes from the upstream resource and the
+// buffer grows to the high-water mark on the next reset, so steady-state frames never allocate.
+// Debug builds fill released memory with 0xDD to catch use after the frame ended.
+class FrameArena : public std::pmr::memory_resource {
+public:
+    explicit FrameArena(std::size_t capacity = 256 * 1024,
+        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // releases everything allocated this frame
+    void reset();
+
+    std::size_t used() const { return m_offset + m_overflowBytes; }
+    std::size_t capacity() const { return m_capacity; }
+    std::size_t highWater() const { return m_highWater; }
+    // number of upstream allocations since construction (should stay constant after warm-up)
+    std::size_t overflows() const { return m_overflowCount; }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    struct Block {
+        void* ptr;
+        std::size_t bytes;
+        std::size_t alignment;
+    };
+
+    std::pmr::memory_resource* m_upstream;
+    std::unique_ptr<std::byte[]> m_buffer;
+    std::size_t m_capacity;
+    std::size_t m_offset = 0;
+    std::size_t m_highWater = 0;
+
+    std::vector<Block> m_overflow;
+    std::size_t m_overflowBytes = 0;
+    std::size_t m_overflowCount = 0;
+};
@@ -0,0 +1,113 @@
+#include "FramePacer.h"
+#include <SFML/System/Sleep.hpp>
+#include <algorithm>
+
+namespace {
+    // pump events at least this often while sleeping
+    const sf::Time SleepSlice = sf::milliseconds(1);
+    // LowLatency never runs faster than this, in case the driver ignores vsync
+    const sf::Time MinInterval = sf::seconds(1.f / 240.f);
+    const sf::Time MinMargin = sf::microseconds(500);
+
+    sf::Time lerp(sf::Time from, sf::Time to, float t) {
+        return from + (to - from) * t;
+    }
+}
+
+const char* FramePacer::modeName(Mode mode) {
+    switch (mode) {
+    case Mode::Uncapped:   return "uncapped";
+    case Mode::VSync:      return "vsync";
+    case Mode::Limiter:    return "limiter";
+    case Mode::LowLatency: return "low latency";
+    default:               return "?";
+    }
+}
+
+void FramePacer::setMode(Mode mode, sf::Window& window) {
+    m_mode = mode;
+    window.setVerticalSyncEnabled(mode == Mode::VSync or mode == Mode::LowLatency);
+    reset();
+}
+
+void FramePacer::reset() {
+    m_next = m_clock.getElapsedTime();
+    m_lastPresent = m_next;
+    m_refresh = sf::Time::Zero;
+    m_margin = sf::milliseconds(1);
+}
+
+sf::Time FramePacer::budget() const {
+    switch (m_mode) {
+    case Mode::Limiter:    return m_period;
+    case Mode::LowLatency: return m_refresh == sf::Time::Zero ? m_period : std::max(m_refresh, MinInterval) - m_margin;
+    default:               return sf::seconds(1.f / 60.f);
+    }
+}
+
+sf::Time FramePacer::deadline(sf::Time now) {
+    switch (m_mode) {
+    case Mode::Limiter:
+        m_next += m_period;
+        // too late already: start over from now instead of rushing to catch up
+        if (m_next < now - m_period) m_next = now;
+        return m_next;
+    case Mode::LowLatency:
+        if (m_refresh == sf::Time::Zero) return now; // still measuring
+        return m_lastPresent + std::max(m_refresh, MinInterval) - m_work - m_margin;
+    default:
+        return now;
+    }
+}
+
+FramePacer::Waited FramePacer::wait(const std::function<void()>& pump) {
+    Waited waited;
+    sf::Time now = m_clock.getElapsedTime();
+    const sf::Time until = deadline(now);
+
+    // sleep while the remaining time is longer than sf::sleep tends to overshoot
+    while (until - now > m_oversleep + SleepSlice / 2.f) {
+        const sf::Time request = std::min(SleepSlice, until - now - m_oversleep);
+        sf::sleep(request);
+        const sf::Time after = m_clock.getElapsedTime();
+        const sf::Time over = after - now - request;
+        m_oversleep = lerp(m_oversleep, std::max(over, sf::Time::Zero), 0.05f);
+        waited.slept += after - now;
+        now = after;
+        if (pump) pump();
+        now = m_clock.getElapsedTime();
+    }
+    const sf::Time spinStart = now;
+    while (now < until)
+        now = m_clock.getElapsedTime();
+    waited.spun = now - spinStart;
+
+    m_frameStart = now;
+    return waited;
+}
+
+void FramePacer::rendered() {
+    m_renderedAt = m_clock.getElapsedTime();
+    const sf::Time work = m_renderedAt - m_frameStart;
+    // jumps up at once, comes down slowly: a single slow frame shouldn't miss twice
+    m_work = work > m_work ? work : lerp(m_work, work, 0.05f);
+}
+
+void FramePacer::presented() {
+    const sf::Time now = m_clock.getElapsedTime();
+    m_interval = now - m_lastPresent;
+    m_lastPresent = now;
+    if (m_mode != Mode::LowLatency) return;
+
+    if (m_refresh == sf::Time::Zero) {
+        m_refresh = m_interval;
+    }
+    else if (m_interval > m_refresh + m_refresh / 2.f) {
+        // missed a blank: leave more room
+        m_margin = std::min(m_margin * 2.f + MinMargin, m_refresh / 2.f);
+    }
+    else {
+        m_refresh = lerp(m_refresh, m_interval, 0.05f);
+        m_margin = std::max(m_margin - sf::microseconds(10), MinMargin);
+    }
+}
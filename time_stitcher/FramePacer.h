@@ -0,0 +1,69 @@
+#pragma once
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/Window/Window.hpp>
+#include <functional>
+
+// Decides when the next frame starts.
+//   VSync:      display() blocks until the vertical blank, nothing else to do
+//   Limiter:    sleeps most of the way to the target rate and spins the rest; the spin margin
+//               follows how much sf::sleep has been overshooting
+//   LowLatency: vsync, but after a present it waits until just enough time is left for one
+//               frame of work before the next vertical blank, so input is sampled as late as
+//               possible. The refresh interval and the work time are measured, the safety
+//               margin grows when a blank is missed and slowly shrinks again otherwise.
+class FramePacer {
+public:
+    enum class Mode {
+        Uncapped,
+        VSync,
+        Limiter,
+        LowLatency,
+        Count
+    };
+    static const char* modeName(Mode mode);
+
+    struct Waited {
+        sf::Time slept;
+        sf::Time spun;
+    };
+
+    void setMode(Mode mode, sf::Window& window);
+    Mode mode() const { return m_mode; }
+    // forgets the measurements, after a pause the next intervals are not comparable
+    void reset();
+    // frames per second of the Limiter
+    void setTargetRate(float hz) { m_period = sf::seconds(1.f / hz); }
+
+    // waits until the next frame should start; pump runs between the sleeps so input events
+    // are timestamped close to when they arrived rather than when the wait ends
+    Waited wait(const std::function<void()>& pump);
+    // around display(): the work of a frame is the time from the end of wait() to rendered()
+    void rendered();
+    void presented();
+
+    sf::Time presentInterval() const { return m_interval; }
+    sf::Time refreshInterval() const { return m_refresh; }
+    sf::Time workEstimate() const { return m_work; }
+    // end of the last wait() to the last present, blocking in display() included
+    sf::Time frameTime() const { return m_lastPresent - m_frameStart; }
+    // what frameTime() may take without the frame rate dropping. With plain vsync the wait
+    // for the blank is part of every frame time, so it tells nothing about the cost there.
+    sf::Time budget() const;
+
+private:
+    sf::Time deadline(sf::Time now);
+
+    Mode m_mode = Mode::Uncapped;
+    sf::Clock m_clock;
+    sf::Time m_period = sf::seconds(1.f / 120.f);
+    sf::Time m_next;           // Limiter: start of the next frame
+    sf::Time m_frameStart;
+    sf::Time m_renderedAt;
+    sf::Time m_lastPresent;
+    sf::Time m_interval;       // last present to present
+    sf::Time m_refresh;        // smoothed interval of the frames that didn't miss a blank
+    sf::Time m_work;           // decaying maximum of the frame work
+    sf::Time m_margin = sf::milliseconds(1);
+    sf::Time m_oversleep = sf::microseconds(500);
+};
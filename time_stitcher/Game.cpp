@@ -1,5 +1,10 @@
 #include "Game.h"
+#include "Systems.h"
 #include <iostream>
+#include <cstdio>
+#include <string_view>
+#include <algorithm>
+#include <random>
 
 // Test
 // Helper to create SFML VideoMode
@@ -10,23 +15,43 @@ sf::VideoMode CreateVideoMode(unsigned width, unsigned height) {
     return mode;
 }
 
+namespace {
+    const ParticleEffect TouchSparks{ 40, 60.f, 220.f, 0.2f, 0.5f, 3.f, sf::Color(255, 230, 90) };
+    const ParticleEffect StitchBurst{ 400, 80.f, 420.f, 0.4f, 1.2f, 4.f, sf::Color(200, 120, 255) };
+    const ParticleEffect RewindTrail{ 1500, 20.f, 120.f, 0.3f, 0.9f, 3.f, sf::Color(120, 200, 255) }; // per second
+
+    // live echoes; past that the oldest makes room, so the pools warmed up below never grow
+    constexpr std::size_t MaxEchoes = 512;
+    // rift lights kept; each has a light texture and is drawn into the light map every frame
+    constexpr std::size_t MaxRifts = 8;
+}
+
 Game::Game(unsigned width, unsigned height)
     : window(CreateVideoMode(width, height), "Time Stitcher"),
+    camera(sf::FloatRect({ 0.f, 0.f }, { static_cast<float>(width), static_cast<float>(height) })),
+    resolution(static_cast<float>(height)),
+    world(jobs),
+    pathfinder(navGrid),
+    flowField(jobs),
+    raycaster(navGrid, Maze::TileSize),
     player("assets/images/player_sprites/player.png", { width / 2.f, height / 2.f }, 400.f)
 {
+    memory::Scope tag(memory::Tag::Assets);
     if (not backgroundTexture.loadFromFile("assets/images/background.jpg")) {
         std::cerr << "Failed to load background\n";
     }
     else {
-        // construct the sprite only after the texture is loaded
-        background.emplace(backgroundTexture);
-        auto texSize = backgroundTexture.getSize();
-        if (texSize.x > 0) {
-            background->setScale(
-                { static_cast<float>(width) / texSize.x,
-                  static_cast<float>(height) / texSize.y }
-            );
-        }
+        // resampled once per window size, mipmaps keep the downscale from aliasing
+        backgroundTexture.setSmooth(true);
+        if (not backgroundTexture.generateMipmap()) std::cerr << "No mipmaps for the background\n";
+        resolution.setBackground(&backgroundTexture);
+    }
+    resolution.resize(window.getSize());
+
+    // repeated: merged wall rectangles tile it once per maze tile
+    wallTexture = textures.get("assets/images/obstacle_32x32.png", true, true);
+    if (not wallTexture) {
+        std::cerr << "Walls are drawn untextured\n";
     }
 
     /*player.setDirectionalTextures({
@@ -47,51 +72,497 @@ Game::Game(unsigned width, unsigned height)
     }
     // optional: animate idle frames too
     player.setAnimateIdle(true);
+
+    // echoes look like the player; one texture for all frames lets them share a single draw
+    echoAnimations = player.animations().packed();
+    echoes.setAnimations(&echoAnimations);
+    ghosts.setAnimations(echoAnimations.frameCount() > 0 ? &echoAnimations : nullptr, sf::Color(120, 220, 255, 170));
+
+    // warm up the entity pools so spawning echoes and obstacles doesn't allocate while playing
+    registry.reserve<Position, Velocity, Collider, Chaser, Animated, TimelineSlot, TreeProxy, SweepProxy, Obstacle>(1024);
+    obstacleTree.reserve(1024);
+    movers.reserve(1024);
+    echoes.reserve(1024);
+    echoRing.assign(MaxEchoes, NullEntity);
+    riftRing.assign(MaxRifts, Lighting::NoLight);
+    particles.setJobs(&jobs);
+    raycaster.setObstacles(&obstacleTree, [this](std::uint32_t e, sf::FloatRect& box) {
+        const Obstacle& obs = registry.get<Obstacle>(e);
+        box = obs.getBounds();
+        return obs.m_collidable;
+    });
+    ghosts.reserve(1024);
 }
 
-void Game::createMaze(sf::Vector2f startPos, sf::Vector2f endPos) {
-    // obstacles.emplace_back(sf::Vector2f(200, 200));
-    obstacles.clear();
+void Game::createMaze(sf::Vector2f startPos, sf::Vector2f endPos, std::uint32_t seed) {
+    memory::Scope tag(memory::Tag::Simulation);
+    // spawnObstacle(sf::Vector2f(200, 200));
+    registry.clear();
+    obstacleTree.clear();
+    movers.clear();
+    particles.clear();
+    tick = 0;
+    hashLog.clear();
+    echoes.clear();
+    std::fill(echoRing.begin(), echoRing.end(), NullEntity);
+    echoNext = 0;
+    ghosts.clear();
+
+    // the maze is generated lazily, chunk by chunk, around the player
+    maze = Maze(seed);
+    startTile = maze.nearestCell(maze.tileAt(startPos));
+    goalTile = maze.nearestCell(maze.tileAt(endPos));
 
+    // whole maze as a bitmap (1 bit per tile) for path queries
+    navGrid = TileGrid::fromMaze(maze);
+    pathfinder.rebind(navGrid);
+    raycaster.rebind(navGrid);
+    flowField.reset(navGrid);
+    fog.reset(navGrid, Maze::TileSize);
+    hintPath.clear();
+
+#ifdef _DEBUG
+    std::vector<sf::Vector2i> route;
+    if (not pathfinder.findPath(startTile, goalTile, route))
+        std::cerr << "Maze has no route from start to goal\n";
+#endif
+
+    player.setPosition(maze.tileCenter(startTile));
+    lighting.clear();
+    std::fill(riftRing.begin(), riftRing.end(), Lighting::NoLight);
+    riftNext = 0;
+    torch = lighting.add(player.getPosition(), Maze::TileSize * 6.f, sf::Color(255, 220, 170));
+    lighting.add(maze.tileCenter(goalTile), Maze::TileSize * 3.f, sf::Color(120, 200, 255));
+    world.reset(maze);
+    world.prime(player.getPosition());
+    recorder.start(player.getPosition());
+    present = timeline.start(player.getPosition());
 }
 
 void Game::run() {
-    this->createMaze({ 0.f,0.f }, { 0.f,0.f });
+    this->createMaze(maze.tileCenter({ 1, 1 }), maze.tileCenter({ maze.width() - 2, maze.height() - 2 }),
+                     static_cast<std::uint32_t>(std::random_device{}()));
+    pacer.setMode(FramePacer::Mode::LowLatency, window);
+    float accumulator = 0.f;
     while (window.isOpen()) {
-        processEvents();
-        render();
-        update(clock.restart().asSeconds());
+        if (runState.state() == RunState::State::Active) {
+            FramePacer::Waited waited = pacer.wait([this] { processEvents(); });
+            profiler.add(Profiler::Phase::Sleep, waited.slept);
+            profiler.add(Profiler::Phase::Spin, waited.spun);
+        }
+        else {
+            Profiler::Scope scope(profiler, Profiler::Phase::Sleep);
+            sf::sleep(runState.wakeInterval());
+        }
+        {
+            Profiler::Scope scope(profiler, Profiler::Phase::Events);
+            processEvents();
+        }
+        float dt = clock.restart().asSeconds();
+        // the simulation only ever steps by sim::TickTime; a long stall doesn't turn into
+        // hundreds of catch-up ticks
+        if (runState.simulates()) accumulator += std::min(dt, 0.25f);
+        const sf::Time frameEnd = input.now();
+        {
+            Profiler::Scope scope(profiler, Profiler::Phase::Simulation);
+            while (accumulator >= sim::TickTime) {
+                // each tick sees the key transitions up to its own end in wall time
+                input.advanceTo(frameEnd - sf::seconds(accumulator - sim::TickTime));
+                update(sim::TickTime);
+                hashLog.push(hashState());
+                ++tick;
+                accumulator -= sim::TickTime;
+            }
+        }
+        // rendered after the ticks, so the frame shows the input just sampled
+        if (runState.renders()) {
+            {
+                Profiler::Scope scope(profiler, Profiler::Phase::Render);
+                render();
+            }
+            pacer.rendered();
+            {
+                Profiler::Scope scope(profiler, Profiler::Phase::Present);
+                window.display();
+            }
+            pacer.presented();
+            runState.rendered();
+            if (pacer.mode() != FramePacer::Mode::VSync) resolution.adapt(pacer.frameTime(), pacer.budget());
+        }
+        sf::Time inputTime;
+        if (input.takeOldestApplied(inputTime)) profiler.addLatency(input.now() - inputTime);
+        profiler.endFrame();
+
+        frameArena.reset();
+        memory::endFrame();
+        updateHud(dt);
+    }
+
+    memory::dump(std::cout, gpuBytes());
+    std::cout << "Frame arena: high-water " << frameArena.highWater() << " of " << frameArena.capacity()
+        << " bytes, " << frameArena.overflows() << " overflow allocations\n";
+    // the profiler holds what was measured since the last HUD update
+    std::cout << "Frame phases, mean over the last " << profiler.frames() << " frames:";
+    for (std::size_t i = 0; i < static_cast<std::size_t>(Profiler::Phase::Count); ++i) {
+        const auto phase = static_cast<Profiler::Phase>(i);
+        std::cout << ' ' << Profiler::phaseName(phase) << ' ' << profiler.average(phase).asMicroseconds() / 1000.0 << " ms";
     }
-    
+    std::cout << "\nFrame pacer (" << FramePacer::modeName(pacer.mode()) << "): present interval "
+        << pacer.presentInterval().asMicroseconds() / 1000.0 << " ms, refresh " << pacer.refreshInterval().asMicroseconds() / 1000.0
+        << " ms, work " << pacer.workEstimate().asMicroseconds() / 1000.0 << " ms\n";
+#ifdef _DEBUG
+    // compare with the log of another build/run with the same inputs (StateHashLog::firstDivergence)
+    hashLog.saveToFile("state_hashes.bin");
+#endif
 }
 
 void Game::processEvents() {
     while (auto event = window.pollEvent()) {
+        input.handle(*event);
+        if (const auto* resized = event->getIf<sf::Event::Resized>()) {
+            // same world units on screen, more or less of the world to the sides
+            resolution.resize(resized->size);
+            if (resolution.size() == resized->size) camera.setSize(resolution.viewSize());
+        }
+        if (runState.handle(*event)) {
+            // the time spent in the previous state is neither simulated nor presented
+            clock.restart();
+            pacer.reset();
+        }
         if (event->is<sf::Event::Closed>())
             window.close();
+        else if (const auto* key = event->getIf<sf::Event::KeyPressed>()) {
+            if (key->code == sf::Keyboard::Key::H) showHint();
+            if (key->code == sf::Keyboard::Key::P) {
+                // cycles the frame pacing modes
+                auto next = (static_cast<int>(pacer.mode()) + 1) % static_cast<int>(FramePacer::Mode::Count);
+                pacer.setMode(static_cast<FramePacer::Mode>(next), window);
+            }
+        }
+    }
+    if (window.isOpen() and runState.poll(window.getSize())) {
+        clock.restart();
+        pacer.reset();
     }
 }
 
+// toggles a line from the player to the goal
+void Game::showHint() {
+    if (hintPath.getVertexCount() > 0) {
+        hintPath.clear();
+        return;
+    }
+    std::vector<sf::Vector2i> route;
+    if (not pathfinder.findPath(maze.tileAt(player.getPosition()), goalTile, route)) return;
+    for (const auto& tile : route)
+        hintPath.append(sf::Vertex{ maze.tileCenter(tile), sf::Color::Cyan });
+}
+
+// ends the current run: it is played back as a ghost from its start while a new run is recorded
+void Game::stitch() {
+    memory::Scope tag(memory::Tag::Simulation);
+    if (recorder.track().ticks == 0) return;
+    ghosts.spawn(ghosts.addTrack(recorder.finish()));
+    particles.burst(player.getPosition(), StitchBurst);
+    recorder.start(player.getPosition());
+}
+
+// keeps the present as a branch point and continues in a new branch; recording restarts
+// here so a rewind can replay exactly the branch
+void Game::fork() {
+    memory::Scope tag(memory::Tag::Simulation);
+    timeline.branch(present).player = player.getPosition();
+    present = timeline.fork(present);
+    // a rift glows where the timeline forked; the oldest one fades to make room
+    Lighting::LightId& rift = riftRing[riftNext];
+    riftNext = (riftNext + 1) % riftRing.size();
+    lighting.remove(rift);
+    rift = lighting.add(player.getPosition(), Maze::TileSize * 2.5f, sf::Color(200, 120, 255));
+    recorder.start(player.getPosition());
+}
+
+// back to the last branch point: the run since then becomes a ghost and what it did to the
+// obstacles is merged into a fresh branch of that point
+void Game::rewind() {
+    memory::Scope tag(memory::Tag::Simulation);
+    Timeline::BranchId parent = timeline.branch(present).parent;
+    if (parent == Timeline::NoBranch) return;
+    stitch();
+    Timeline::BranchId next = timeline.fork(parent);
+    timeline.merge(next, present);
+    present = next;
+    systems::applyTimeline(registry, timeline.branch(present).obstacles);
+    player.setPosition(timeline.branch(present).player);
+    particles.startEmitter(player.getPosition(), 0.4f, RewindTrail);
+    recorder.start(player.getPosition());
+}
+
+Entity Game::spawnObstacle(const sf::Vector2f& position, const std::string& texturePath) {
+    Entity e = registry.create();
+    const sf::Texture* texture = texturePath.empty() ? nullptr : textures.get(texturePath);
+    Obstacle& obs = registry.emplace<Obstacle>(e, position, texture, textures.maskOf(texture));
+    std::uint32_t index = timeline.branch(present).obstacles.push_back({ obs.getBounds().getCenter(), obs.m_collidable });
+    registry.emplace<TimelineSlot>(e, index);
+    registry.emplace<TreeProxy>(e, obstacleTree.insert(obs.getBounds(), e));
+    return e;
+}
+
+// a time echo follows the flow field towards the player
+Entity Game::spawnEcho(const sf::Vector2f& position) {
+    Entity& slot = echoRing[echoNext];
+    echoNext = (echoNext + 1) % echoRing.size();
+    systems::despawnEcho(registry, movers, echoes, slot);
+    slot = systems::spawnEcho(registry, movers, echoes, position, player.clipFor({ 0.f, 0.f }), sf::Color(180, 80, 255, 200));
+    return slot;
+}
+
+// narrow phase against the wall rectangles once the player's box touches a wall
+bool Game::hitsWall() {
+    const CollisionMask* mask = player.mask();
+    if (not mask) return true;
+    std::pmr::vector<sf::FloatRect> walls(&frameArena);
+    // a chunk that isn't loaded yet: keep the box result
+    if (not world.overlappingWalls(player.getBounds(), walls)) return true;
+    for (const sf::FloatRect& wall : walls)
+        if (collision::overlaps(*mask, player.maskTopLeft(), sf::IntRect(sf::Vector2i(wall.position), sf::Vector2i(wall.size)))) return true;
+    return false;
+}
+
 void Game::update(float dt) {
+    // actions that change the simulation go through the input queue like movement, so they
+    // land on the tick their key press maps to and not wherever the event pump ran
+    if (input.pressed(sf::Keyboard::Key::F9)) loadSnapshot("quicksave.tss");
+    if (input.pressed(sf::Keyboard::Key::F5)) saveSnapshot("quicksave.tss");
+    if (input.pressed(sf::Keyboard::Key::E)) spawnEcho(maze.tileCenter(startTile));
+    if (input.pressed(sf::Keyboard::Key::G)) stitch();
+    if (input.pressed(sf::Keyboard::Key::F)) fork();
+    if (input.pressed(sf::Keyboard::Key::R)) rewind();
+
+    memory::Scope tag(memory::Tag::Simulation);
     sf::Vector2f prevPos = player.getPosition();
-    player.update(dt, window.getSize());
+    player.update(dt, maze.bounds(), input);
+    if (world.collides(player.getBounds()) and hitsWall())
+        player.setPosition(prevPos);
+
+    std::pmr::vector<Entity> contacts(&frameArena);
+    if (const CollisionMask* mask = player.mask())
+        systems::overlappingObstacles(registry, obstacleTree, player.getBounds(), *mask, player.maskTopLeft(), contacts);
+    else
+        systems::overlappingObstacles(registry, obstacleTree, player.getBounds(), contacts);
+    for (Entity e : contacts)
+        registry.get<Obstacle>(e).touched();
+    if (not contacts.empty())
+        player.setPosition(prevPos);
+    recorder.record(player.getPosition(), dt);
+    ghosts.update(registry, obstacleTree, player, dt);
+
+    systems::chase(registry, flowField, maze, raycaster, player.getPosition(), &frameArena);
+    systems::move(registry, world, obstacleTree, dt);
+    systems::collideMovers(registry, movers);
+    systems::touchEffects(registry, particles, TouchSparks);
+    systems::obstacles(registry);
+    systems::updateObstacleTree(registry, obstacleTree);
+    systems::recordTimeline(registry, timeline.branch(present).obstacles);
+    systems::animate(registry, echoes, player, dt);
+    registry.flush();
+
+    world.update(player.getPosition());
+    flowField.update(maze.tileAt(player.getPosition()));
+    particles.update(dt);
+    camera.setCenter(player.getPosition());
+}
+
+void Game::render() {
+    memory::Scope tag(memory::Tag::Rendering);
+    window.clear();
+    // background stays in screen space, the world follows the camera
+    window.setView(resolution.screenView());
+    resolution.drawBackground(window);
+
+    sf::RenderTarget& target = resolution.beginWorld(window, camera);
+    world.draw(target, wallTexture);
+    if (hintPath.getVertexCount() > 0) target.draw(hintPath);
+    ghosts.draw(target);
+    if (echoAnimations.frameCount() > 0) echoes.draw(target);
+    else systems::drawChasers(registry, target, echoBatch);
+    player.draw(target);
+    systems::drawObstacles(registry, target);
+    particles.draw(target);
+    // only recomputed when the player enters another tile
+    fog.update(maze.tileAt(player.getPosition()));
+    fog.draw(target);
+    resolution.endWorld(window);
+
+    // over the whole frame, background included
+    lighting.move(torch, player.getPosition());
+    lighting.update(world, sf::FloatRect(camera.getCenter() - camera.getSize() * 0.5f, camera.getSize()), &frameArena);
+    lighting.draw(window, camera);
+}
+
+// maze seed, player, obstacles, echoes, ghosts, the run being recorded and the tick hashes;
+// branches of the timeline are not kept (a loaded game starts a new timeline)
+bool Game::saveSnapshot(const std::string& path) {
+    memory::Scope tag(memory::Tag::Simulation);
+    using namespace snapshot;
+    SnapshotWriter out;
+
+    const AnimationState& anim = player.animationState();
+    WorldRecord world{};
+    world.mazeSeed = maze.seed();
+    world.mazeWidth = maze.width();
+    world.mazeHeight = maze.height();
+    world.startX = startTile.x;
+    world.startY = startTile.y;
+    world.goalX = goalTile.x;
+    world.goalY = goalTile.y;
+    world.tick = tick;
+    world.playerX = player.getPosition().x;
+    world.playerY = player.getPosition().y;
+    world.playerDirection = static_cast<std::int32_t>(player.direction());
+    world.animClip = anim.clip;
+    world.animFrame = anim.frame;
+    world.animTimer = anim.timer;
+    out.addOwned(Section::World, std::vector<WorldRecord>{ world });
+
+    std::vector<ObstacleRecord> obstacles;
+    std::vector<char> strings;
+    obstacles.reserve(registry.pool<Obstacle>().entities().size());
+    registry.each<Obstacle>([&](Entity, Obstacle& obs) {
+        const std::string& texturePath = textures.pathOf(obs.m_texture);
+        std::int32_t texture = -1;
+        if (not texturePath.empty()) {
+            // few distinct textures, a linear search is fine
+            std::string_view all(strings.data(), strings.size());
+            std::size_t found = all.find(std::string_view(texturePath.c_str(), texturePath.size() + 1));
+            if (found == std::string_view::npos) {
+                found = strings.size();
+                strings.insert(strings.end(), texturePath.c_str(), texturePath.c_str() + texturePath.size() + 1);
+            }
+            texture = static_cast<std::int32_t>(found);
+        }
+        Vector2f p = obs.getPosition();
+        obstacles.push_back({ p.x, p.y, obs.m_touchTicks, texture,
+                              static_cast<std::uint8_t>(obs.m_collidable), static_cast<std::uint8_t>(obs.m_didTouch), {} });
+    });
+    out.addOwned(Section::Obstacles, std::move(obstacles));
+    out.addOwned(Section::Strings, std::move(strings));
+
+    std::vector<ChaserRecord> chasers;
+    registry.each<Chaser, Position, Velocity>([&](Entity, Chaser& chaser, Position& pos, Velocity& vel) {
+        chasers.push_back({ pos.value.x, pos.value.y, vel.value.x, vel.value.y, chaser.speed });
+    });
+    out.addOwned(Section::Chasers, std::move(chasers));
 
-    for (auto& obs : obstacles) {
-        if (obs.intersects(player.getBounds())) {
+    ghosts.write(out);
+    recorder.write(out);
+    out.add(Section::Hashes, hashLog.hashes());
+    return out.save(path);
+}
+
+bool Game::loadSnapshot(const std::string& path) {
+    memory::Scope tag(memory::Tag::Simulation);
+    using namespace snapshot;
+    Snapshot in;
+    if (not in.load(path)) return false;
+    const WorldRecord* saved = in.one<WorldRecord>(Section::World);
+    if (not saved or saved->mazeWidth != maze.width() or saved->mazeHeight != maze.height()) {
+        std::cerr << path << " has no usable world\n";
+        return false;
+    }
+    // checked before anything is torn down: a damaged file leaves the running game as it was
+    if (not Ghosts::check(in) or not GhostRecorder::check(in)) {
+        std::cerr << path << ": ghost tracks don't match their tick counts\n";
+        return false;
+    }
+
+    createMaze(maze.tileCenter({ saved->startX, saved->startY }), maze.tileCenter({ saved->goalX, saved->goalY }), saved->mazeSeed);
+    tick = saved->tick;
+    player.setPosition({ saved->playerX, saved->playerY });
+    player.restoreAnimation(static_cast<Player::Direction>(saved->playerDirection),
+                            AnimationState{ saved->animClip, saved->animFrame, saved->animTimer });
+
+    auto strings = in.get<char>(Section::Strings);
+    for (const ObstacleRecord& record : in.get<ObstacleRecord>(Section::Obstacles)) {
+        std::string texturePath;
+        if (record.texture >= 0 and static_cast<std::size_t>(record.texture) < strings.size()) {
+            const char* first = strings.data() + record.texture;
+            texturePath.assign(first, std::find(first, strings.data() + strings.size(), '\0'));
+        }
+        Obstacle& obs = registry.get<Obstacle>(spawnObstacle({ record.x, record.y }, texturePath));
+        if (obs.m_collidable != static_cast<bool>(record.collidable)) obs.setCollideable(record.collidable != 0);
+        if (record.didTouch) {
             obs.touched();
-            player.setPosition(prevPos);
+            obs.m_touchTicks = record.touchTicks;
         }
-        obs.update(dt);
     }
+    for (const ChaserRecord& record : in.get<ChaserRecord>(Section::Chasers)) {
+        Entity e = spawnEcho({ record.x, record.y });
+        registry.get<Velocity>(e).value = { record.vx, record.vy };
+        registry.get<Chaser>(e).speed = record.speed;
+    }
+
+    ghosts.read(in);
+    recorder.read(in);
+    if (not recorder.recording()) recorder.start(player.getPosition());
+    auto hashes = in.get<std::uint64_t>(Section::Hashes);
+    // the saved hashes are the ones of the last ticks before the save
+    if (hashes.size() > saved->tick) hashes = hashes.last(saved->tick);
+    hashLog.assign(saved->tick - hashes.size(), hashes.data(), hashes.size());
+
+    world.prime(player.getPosition());
+    camera.setCenter(player.getPosition());
+    return true;
 }
 
-void Game::render() {
-    window.clear();
-    if (background) window.draw(*background);
-    player.draw(window);
+// everything the simulation changes; identical inputs must give identical hashes
+std::uint64_t Game::hashState() {
+    StateHasher hasher;
+    hasher.add(tick);
+    hasher.add(player.getPosition());
+    systems::hashState(registry, hasher);
+    ghosts.hash(hasher);
+    return hasher.digest();
+}
 
-    for (auto& obs : obstacles)
-        obs.draw(window);
+std::size_t Game::gpuBytes() const {
+    std::size_t total = textures.bytes() + memory::textureBytes(backgroundTexture) + player.textureBytes() + echoAnimations.textureBytes()
+        + resolution.textureBytes() + fog.textureBytes() + lighting.textureBytes();
+    return total;
+}
+
+// fps, present interval, main thread times, allocations per frame and memory per subsystem in
+// the title bar, twice a second
+void Game::updateHud(float dt) {
+    hudTimer += dt;
+    ++hudFrames;
+    if (hudTimer < 0.5f) return;
 
-    window.display();
-}
\ No newline at end of file
+    constexpr double MB = 1024.0 * 1024.0;
+    char text[448];
+    std::snprintf(text, sizeof(text),
+        "Time Stitcher | %s | %.0f fps %s | present %.2f ms | scale %.0f%% | cpu %.0f%% (sim %.1f, render %.1f ms) | input->present %.1f ms (max %.1f) | %llu allocs/frame | heap %.1f MB (assets %.1f, sim %.1f, render %.1f, stream %.1f) | gpu ~%.1f MB | tick %llu %016llx",
+        RunState::stateName(runState.state()),
+        hudFrames / hudTimer,
+        FramePacer::modeName(pacer.mode()),
+        pacer.presentInterval().asSeconds() * 1000.f,
+        resolution.renderScale() * 100.f,
+        profiler.busy() * 100.f,
+        profiler.average(Profiler::Phase::Simulation).asSeconds() * 1000.f,
+        profiler.average(Profiler::Phase::Render).asSeconds() * 1000.f,
+        profiler.averageLatency().asSeconds() * 1000.f,
+        profiler.maxLatency().asSeconds() * 1000.f,
+        static_cast<unsigned long long>(memory::frameAllocations()),
+        memory::liveBytes() / MB,
+        memory::liveBytes(memory::Tag::Assets) / MB,
+        memory::liveBytes(memory::Tag::Simulation) / MB,
+        memory::liveBytes(memory::Tag::Rendering) / MB,
+        memory::liveBytes(memory::Tag::Streaming) / MB,
+        gpuBytes() / MB,
+        static_cast<unsigned long long>(tick),
+        static_cast<unsigned long long>(hashLog.last()));
+    window.setTitle(text);
+
+    hudTimer = 0.f;
+    hudFrames = 0;
+    profiler.reset();
+}
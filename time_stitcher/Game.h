@@ -4,6 +4,34 @@
 #include <vector>
 #include "Player.h"
 #include "Obstacle.h"
+#include "Maze.h"
+#include "JobSystem.h"
+#include "ChunkWorld.h"
+#include "TileGrid.h"
+#include "Pathfinder.h"
+#include "FlowField.h"
+#include "Ecs.h"
+#include "Components.h"
+#include "AabbTree.h"
+#include "SweepAndPrune.h"
+#include "Raycaster.h"
+#include "FogOfWar.h"
+#include "Lighting.h"
+#include "Particles.h"
+#include "AnimationBatch.h"
+#include "Ghosts.h"
+#include "Timeline.h"
+#include "Simulation.h"
+#include "StateHash.h"
+#include "Snapshot.h"
+#include "InputState.h"
+#include "FramePacer.h"
+#include "Profiler.h"
+#include "RunState.h"
+#include "ResolutionManager.h"
+#include "TextureCache.h"
+#include "FrameArena.h"
+#include "MemoryTracker.h"
 
 class Game {
 public:
@@ -14,15 +42,69 @@ private:
     void processEvents();
     void update(float dt);
     void render();
-    void createMaze(Vector2f startPos, Vector2f endPos);
+    void createMaze(Vector2f startPos, Vector2f endPos, std::uint32_t seed);
+    bool saveSnapshot(const std::string& path);
+    bool loadSnapshot(const std::string& path);
+    void showHint();
+    void stitch();
+    void fork();
+    void rewind();
+    void updateHud(float dt);
+    bool hitsWall();
+    std::size_t gpuBytes() const;
+    std::uint64_t hashState();
+    Entity spawnObstacle(const sf::Vector2f& position, const std::string& texturePath = "");
+    Entity spawnEcho(const sf::Vector2f& position);
 
 
     sf::RenderWindow window;
+    InputState input;
+    TextureCache textures;
+    sf::View camera;
+    ResolutionManager resolution;
     sf::Texture backgroundTexture;
-    std::optional<sf::Sprite> background;
-    
+    const sf::Texture* wallTexture = nullptr;
+
+    JobSystem jobs;
+    Maze maze;
+    ChunkWorld world;
+    TileGrid navGrid;
+    Pathfinder pathfinder;
+    FlowField flowField;   // shared chase directions towards the player
+    Raycaster raycaster;   // line of sight through walls and obstacles
+    FogOfWar fog;          // what the player sees of the maze
+    Lighting lighting;     // torch, goal and rifts, shadowed by the walls
+    Lighting::LightId torch = 0;
+    std::vector<Lighting::LightId> riftRing; // rift lights by age, oldest at riftNext
+    std::size_t riftNext = 0;
+    sf::Vector2i startTile;
+    sf::Vector2i goalTile;
+    sf::VertexArray hintPath{ sf::PrimitiveType::LineStrip };
+
     Player player;
-    std::vector<Obstacle> obstacles;
+    Registry registry;          // obstacles, echoes, ...
+    AabbTree obstacleTree;      // broadphase of the obstacles
+    SweepAndPrune movers;       // broadphase of echoes against each other
+    ParticleSystem particles;   // touch, stitch and rewind effects
+    sf::VertexArray echoBatch;  // untextured fallback when the player frames couldn't be packed
+    AnimationSet echoAnimations; // player frames packed into one texture
+    AnimationBatch echoes;
+    std::vector<Entity> echoRing; // live echoes by age, oldest at echoNext
+    std::size_t echoNext = 0;
+    GhostRecorder recorder;     // the current run
+    Ghosts ghosts;              // earlier runs played back
+    Timeline timeline;
+    Timeline::BranchId present = 0;
 
+    RunState runState;
+    FramePacer pacer;
+    Profiler profiler;
+    FrameArena frameArena;      // scratch memory, reset after every frame
     sf::Clock clock;
+    std::uint64_t tick = 0;     // simulation ticks since the maze was created
+    StateHashLog hashLog;
+
+    // stats shown in the window title
+    float hudTimer = 0.f;
+    unsigned hudFrames = 0;
 };
\ No newline at end of file
@@ -0,0 +1,341 @@
+#include "Ghosts.h"
+#include "Obstacle.h"
+#include <algorithm>
+#include <cmath>
+#include <span>
+
+namespace {
+    // zigzag maps small negative and positive deltas to small unsigned values
+    void writeDelta(std::vector<std::uint8_t>& out, std::int32_t value) {
+        std::uint32_t v = (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+        while (v >= 0x80) {
+            out.push_back(static_cast<std::uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(v));
+    }
+
+    std::int32_t readDelta(const std::uint8_t* data, std::uint32_t& cursor) {
+        std::uint32_t v = 0;
+        int shift = 0;
+        std::uint8_t byte;
+        do {
+            byte = data[cursor++];
+            v |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        return static_cast<std::int32_t>(v >> 1) ^ -static_cast<std::int32_t>(v & 1);
+    }
+
+    // steps over `samples` delta pairs without reading past the end; false if the bytes run out
+    bool skipSamples(std::span<const std::uint8_t> deltas, std::uint32_t& cursor, std::uint32_t samples) {
+        for (std::uint64_t n = std::uint64_t(samples) * 2; n > 0; --n) {
+            int length = 0;
+            do {
+                if (cursor >= deltas.size() or ++length > 5) return false;
+            } while (deltas[cursor++] & 0x80);
+        }
+        return true;
+    }
+
+    bool holdsExactly(std::span<const std::uint8_t> deltas, std::uint32_t ticks) {
+        std::uint32_t cursor = 0;
+        return skipSamples(deltas, cursor, ticks) and cursor == deltas.size();
+    }
+
+    sf::Vector2i quantize(const sf::Vector2f& position) {
+        return { static_cast<int>(std::lround(position.x * GhostTrack::Scale)),
+                 static_cast<int>(std::lround(position.y * GhostTrack::Scale)) };
+    }
+}
+
+bool GhostTrack::valid() const {
+    return holdsExactly(deltas, ticks);
+}
+
+void GhostRecorder::start(const sf::Vector2f& position) {
+    m_track = GhostTrack{};
+    m_track.start = quantize(position);
+    m_track.deltas.reserve(64 * 1024); // a few minutes before the first reallocation
+    m_last = m_track.start;
+    m_timer = 0.f;
+    m_recording = true;
+}
+
+void GhostRecorder::record(const sf::Vector2f& position, float dt) {
+    if (not m_recording) return;
+    m_timer += dt;
+    // a long frame repeats the current position rather than inventing a path
+    while (m_timer >= GhostTrack::TickTime) {
+        m_timer -= GhostTrack::TickTime;
+        sf::Vector2i q = quantize(position);
+        writeDelta(m_track.deltas, q.x - m_last.x);
+        writeDelta(m_track.deltas, q.y - m_last.y);
+        m_last = q;
+        ++m_track.ticks;
+    }
+}
+
+GhostTrack GhostRecorder::finish() {
+    m_recording = false;
+    m_track.deltas.shrink_to_fit();
+    return std::move(m_track);
+}
+
+void GhostRecorder::write(SnapshotWriter& out) const {
+    snapshot::RecordingRecord record{ m_track.start.x, m_track.start.y, m_track.ticks, m_last.x, m_last.y, m_timer, m_recording, 0 };
+    out.addOwned(snapshot::Section::Recording, std::vector<snapshot::RecordingRecord>{ record });
+    out.add(snapshot::Section::RecordingBytes, m_track.deltas);
+}
+
+bool GhostRecorder::check(const Snapshot& in) {
+    const auto* record = in.one<snapshot::RecordingRecord>(snapshot::Section::Recording);
+    return not record or holdsExactly(in.get<std::uint8_t>(snapshot::Section::RecordingBytes), record->ticks);
+}
+
+bool GhostRecorder::read(const Snapshot& in) {
+    if (not check(in)) return false;
+    m_recording = false;
+    const auto* record = in.one<snapshot::RecordingRecord>(snapshot::Section::Recording);
+    if (not record) return true;
+    auto bytes = in.get<std::uint8_t>(snapshot::Section::RecordingBytes);
+    m_track = GhostTrack{};
+    m_track.start = { record->startX, record->startY };
+    m_track.ticks = record->ticks;
+    m_track.deltas.reserve(std::max<std::size_t>(bytes.size(), 64 * 1024));
+    m_track.deltas.assign(bytes.begin(), bytes.end());
+    m_last = { record->lastX, record->lastY };
+    m_timer = record->timer;
+    m_recording = record->recording != 0;
+    return true;
+}
+
+void Ghosts::setAnimations(const AnimationSet* set, sf::Color tint) {
+    m_tint = tint;
+    m_batch.setAnimations(set);
+    clear();
+}
+
+std::uint32_t Ghosts::addTrack(GhostTrack track) {
+    m_tracks.push_back(std::move(track));
+    return static_cast<std::uint32_t>(m_tracks.size() - 1);
+}
+
+std::uint32_t Ghosts::spawn(std::uint32_t track) {
+    const GhostTrack& t = m_tracks[track];
+    Playback play;
+    play.prev = play.next = t.start;
+    if (t.ticks > 0) {
+        play.next.x += readDelta(t.deltas.data(), play.cursor);
+        play.next.y += readDelta(t.deltas.data(), play.cursor);
+        play.tick = 1;
+    }
+    sf::Vector2f p = position(play);
+
+    m_track.push_back(track);
+    m_play.push_back(play);
+    m_candidate.push_back(play);
+    m_x.push_back(p.x);
+    m_y.push_back(p.y);
+    m_minX.push_back(0.f);
+    m_minY.push_back(0.f);
+    m_maxX.push_back(0.f);
+    m_maxY.push_back(0.f);
+    m_moved.push_back(0);
+    m_blocked.push_back(0);
+    m_slot.push_back(m_batch.animations()
+        ? m_batch.add(0, p, { 2.f * HalfSize, 2.f * HalfSize }, m_tint)
+        : 0);
+    return static_cast<std::uint32_t>(m_x.size() - 1);
+}
+
+void Ghosts::clear() {
+    m_tracks.clear();
+    m_track.clear();
+    m_play.clear();
+    m_candidate.clear();
+    m_x.clear();
+    m_y.clear();
+    m_minX.clear();
+    m_minY.clear();
+    m_maxX.clear();
+    m_maxY.clear();
+    m_moved.clear();
+    m_blocked.clear();
+    m_slot.clear();
+    m_batch.clear();
+}
+
+void Ghosts::reserve(std::size_t ghosts) {
+    m_track.reserve(ghosts);
+    m_play.reserve(ghosts);
+    m_candidate.reserve(ghosts);
+    m_x.reserve(ghosts);
+    m_y.reserve(ghosts);
+    m_minX.reserve(ghosts);
+    m_minY.reserve(ghosts);
+    m_maxX.reserve(ghosts);
+    m_maxY.reserve(ghosts);
+    m_moved.reserve(ghosts);
+    m_blocked.reserve(ghosts);
+    m_slot.reserve(ghosts);
+    m_batch.reserve(ghosts);
+}
+
+std::size_t Ghosts::trackBytes() const {
+    std::size_t total = 0;
+    for (const auto& track : m_tracks) total += track.deltas.size();
+    return total;
+}
+
+void Ghosts::hash(StateHasher& hasher) const {
+    hasher.add(m_x);
+    hasher.add(m_y);
+    hasher.add(m_blocked);
+}
+
+void Ghosts::write(SnapshotWriter& out) const {
+    std::vector<snapshot::GhostTrackRecord> tracks;
+    std::vector<std::uint8_t> bytes;
+    bytes.reserve(trackBytes());
+    for (const GhostTrack& track : m_tracks) {
+        tracks.push_back({ track.start.x, track.start.y, track.ticks, 0, bytes.size(), track.deltas.size() });
+        bytes.insert(bytes.end(), track.deltas.begin(), track.deltas.end());
+    }
+    out.addOwned(snapshot::Section::GhostTracks, std::move(tracks));
+    out.addOwned(snapshot::Section::GhostTrackBytes, std::move(bytes));
+    out.add(snapshot::Section::GhostTrackIndex, m_track);
+    out.add(snapshot::Section::GhostPlayback, m_play);
+    out.add(snapshot::Section::GhostX, m_x);
+    out.add(snapshot::Section::GhostY, m_y);
+    out.add(snapshot::Section::GhostBlocked, m_blocked);
+}
+
+bool Ghosts::check(const Snapshot& in) {
+    auto tracks = in.get<snapshot::GhostTrackRecord>(snapshot::Section::GhostTracks);
+    auto bytes = in.get<std::uint8_t>(snapshot::Section::GhostTrackBytes);
+    auto trackIndex = in.get<std::uint32_t>(snapshot::Section::GhostTrackIndex);
+    auto play = in.get<Playback>(snapshot::Section::GhostPlayback);
+    const std::size_t n = trackIndex.size();
+    if (play.size() != n or in.get<float>(snapshot::Section::GhostX).size() != n or in.get<float>(snapshot::Section::GhostY).size() != n
+        or in.get<std::uint8_t>(snapshot::Section::GhostBlocked).size() != n)
+        return false;
+
+    for (const auto& record : tracks) {
+        if (record.byteOffset > bytes.size() or record.byteCount > bytes.size() - record.byteOffset) return false;
+        if (not holdsExactly(bytes.subspan(record.byteOffset, record.byteCount), record.ticks)) return false;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        if (trackIndex[i] >= tracks.size()) return false;
+        // the cursor has to sit right after sample `tick`, or playback would decode garbage
+        const auto& record = tracks[trackIndex[i]];
+        std::uint32_t cursor = 0;
+        if (play[i].tick > record.ticks or not skipSamples(bytes.subspan(record.byteOffset, record.byteCount), cursor, play[i].tick)
+            or cursor != play[i].cursor)
+            return false;
+    }
+    return true;
+}
+
+bool Ghosts::read(const Snapshot& in) {
+    if (not check(in)) return false;
+    clear();
+    auto tracks = in.get<snapshot::GhostTrackRecord>(snapshot::Section::GhostTracks);
+    auto bytes = in.get<std::uint8_t>(snapshot::Section::GhostTrackBytes);
+    auto trackIndex = in.get<std::uint32_t>(snapshot::Section::GhostTrackIndex);
+    auto play = in.get<Playback>(snapshot::Section::GhostPlayback);
+    auto xs = in.get<float>(snapshot::Section::GhostX);
+    auto ys = in.get<float>(snapshot::Section::GhostY);
+    auto blocked = in.get<std::uint8_t>(snapshot::Section::GhostBlocked);
+
+    for (const auto& record : tracks) {
+        GhostTrack track;
+        track.start = { record.startX, record.startY };
+        track.ticks = record.ticks;
+        auto first = bytes.begin() + static_cast<std::ptrdiff_t>(record.byteOffset);
+        track.deltas.assign(first, first + static_cast<std::ptrdiff_t>(record.byteCount));
+        addTrack(std::move(track));
+    }
+    for (std::size_t i = 0; i < trackIndex.size(); ++i) {
+        std::uint32_t g = spawn(trackIndex[i]);
+        m_play[g] = m_candidate[g] = play[i];
+        m_x[g] = xs[i];
+        m_y[g] = ys[i];
+        m_blocked[g] = blocked[i];
+        if (m_batch.animations()) m_batch.setPosition(m_slot[g], { xs[i], ys[i] });
+    }
+    return true;
+}
+
+void Ghosts::advance(const GhostTrack& track, Playback& play, float dt) {
+    play.timer += dt;
+    while (play.timer >= GhostTrack::TickTime) {
+        if (play.tick == track.ticks) {
+            // run is over, the ghost stays on its last sample
+            play.prev = play.next;
+            play.timer = 0.f;
+            return;
+        }
+        play.timer -= GhostTrack::TickTime;
+        play.prev = play.next;
+        play.next.x += readDelta(track.deltas.data(), play.cursor);
+        play.next.y += readDelta(track.deltas.data(), play.cursor);
+        ++play.tick;
+    }
+}
+
+sf::Vector2f Ghosts::position(const Playback& play) {
+    float t = play.timer / GhostTrack::TickTime;
+    sf::Vector2f a(play.prev), b(play.next);
+    return (a + (b - a) * t) / GhostTrack::Scale;
+}
+
+void Ghosts::update(Registry& registry, const AabbTree& obstacles, const Player& look, float dt) {
+    const std::size_t n = size();
+    if (n == 0) return;
+
+    // 1) where every ghost would be after dt
+    for (std::size_t i = 0; i < n; ++i) {
+        m_candidate[i] = m_play[i];
+        advance(m_tracks[m_track[i]], m_candidate[i], dt);
+        sf::Vector2f p = position(m_candidate[i]);
+        m_minX[i] = p.x - HalfSize;
+        m_minY[i] = p.y - HalfSize;
+        m_maxX[i] = p.x + HalfSize;
+        m_maxY[i] = p.y + HalfSize;
+        m_moved[i] = p.x != m_x[i] or p.y != m_y[i];
+        m_blocked[i] = 0;
+    }
+
+    // 2) contacts: candidates from the tree, then the obstacle's narrow phase
+    for (std::size_t i = 0; i < n; ++i) {
+        if (not m_moved[i]) continue;
+        const sf::FloatRect box({ m_minX[i], m_minY[i] }, { m_maxX[i] - m_minX[i], m_maxY[i] - m_minY[i] });
+        const sf::IntRect solid({ static_cast<int>(std::lround(box.position.x)), static_cast<int>(std::lround(box.position.y)) },
+                                sf::Vector2i(box.size));
+        obstacles.query(box, [&](int proxy) {
+            Obstacle& obs = registry.get<Obstacle>(obstacles.userData(proxy));
+            if (obs.intersects(box) and obs.overlaps(solid)) {
+                obs.touched();
+                m_blocked[i] = 1;
+            }
+            return true;
+        });
+    }
+
+    // 3) unblocked ghosts take their step
+    for (std::size_t i = 0; i < n; ++i) {
+        sf::Vector2f velocity{ 0.f, 0.f };
+        if (not m_blocked[i]) {
+            m_play[i] = m_candidate[i];
+            sf::Vector2f p = position(m_play[i]);
+            m_x[i] = p.x;
+            m_y[i] = p.y;
+            velocity = sf::Vector2f(m_play[i].next - m_play[i].prev);
+        }
+        if (not m_batch.animations()) continue;
+        m_batch.setPosition(m_slot[i], { m_x[i], m_y[i] });
+        m_batch.play(m_slot[i], look.clipFor(velocity));
+    }
+    m_batch.update(dt);
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "AabbTree.h"
+#include "AnimationBatch.h"
+#include "Ecs.h"
+#include "Player.h"
+#include "Snapshot.h"
+#include "StateHash.h"
+
+// A recorded run: positions sampled at a fixed rate, quantized to 1/Scale px and stored as
+// zigzag varint deltas (one or two bytes per axis and sample while walking, 2 bytes standing still).
+struct GhostTrack {
+    static constexpr float TickTime = 1.f / 30.f;
+    static constexpr float Scale = 4.f;
+
+    sf::Vector2i start;                 // quantized
+    std::uint32_t ticks = 0;            // samples after start
+    std::vector<std::uint8_t> deltas;
+
+    sf::Vector2f startPosition() const { return sf::Vector2f(start) / Scale; }
+    float duration() const { return ticks * TickTime; }
+    // the deltas hold exactly `ticks` samples; checked when a track is loaded, playback trusts it
+    bool valid() const;
+};
+
+// Samples the player every TickTime while recording.
+class GhostRecorder {
+public:
+    void start(const sf::Vector2f& position);
+    void record(const sf::Vector2f& position, float dt);
+    // hands out the run recorded so far and stops
+    GhostTrack finish();
+
+    bool recording() const { return m_recording; }
+    const GhostTrack& track() const { return m_track; }
+
+    void write(SnapshotWriter& out) const;
+    // the recording section holds as many samples as it claims
+    static bool check(const Snapshot& in);
+    // false (and nothing changed) if check fails
+    bool read(const Snapshot& in);
+
+private:
+    GhostTrack m_track;
+    sf::Vector2i m_last;
+    float m_timer = 0.f;
+    bool m_recording = false;
+};
+
+// Plays back any number of recorded runs next to the live player.
+// Ghost state is kept in parallel arrays. Obstacle contacts are found like the player's: the
+// obstacle tree gives the candidates for each moving ghost's box, textured obstacles then test
+// their mask against it. Like the player, a ghost that would run into a collidable obstacle
+// touches it and stays where it is (its playback waits until the way is free).
+class Ghosts {
+public:
+    static constexpr float HalfSize = 20.f;
+
+    // ghosts are drawn from a packed set (see AnimationSet::packed); the set must outlive this
+    void setAnimations(const AnimationSet* set, sf::Color tint);
+
+    // tracks are stored once and can be played by several ghosts
+    std::uint32_t addTrack(GhostTrack track);
+    std::uint32_t spawn(std::uint32_t track);
+    void clear(); // ghosts and tracks
+    void reserve(std::size_t ghosts);
+
+    std::size_t size() const { return m_x.size(); }
+    std::size_t trackCount() const { return m_tracks.size(); }
+    std::size_t trackBytes() const;
+
+    // obstacles: the broadphase of the registry's obstacles, user data is the entity;
+    // `look` picks the clip for a ghost's movement direction
+    void update(Registry& registry, const AabbTree& obstacles, const Player& look, float dt);
+    void draw(sf::RenderTarget& target) const { m_batch.draw(target); }
+    void hash(StateHasher& hasher) const;
+
+    // tracks and playback state; the per ghost arrays are written as they are
+    void write(SnapshotWriter& out) const;
+    // every track holds its ticks and every ghost's cursor fits its track
+    static bool check(const Snapshot& in);
+    // false (and nothing changed) if check fails
+    bool read(const Snapshot& in);
+
+private:
+    struct Playback {
+        std::uint32_t cursor = 0;  // next byte in the track's deltas
+        std::uint32_t tick = 0;    // sample `next` belongs to
+        float timer = 0.f;         // time since sample `prev`
+        sf::Vector2i prev, next;   // quantized samples around the current time
+    };
+    static void advance(const GhostTrack& track, Playback& play, float dt);
+    static sf::Vector2f position(const Playback& play);
+
+    std::vector<GhostTrack> m_tracks;
+
+    // per ghost
+    std::vector<std::uint32_t> m_track;
+    std::vector<Playback> m_play;
+    std::vector<Playback> m_candidate;  // playback after this frame, if nothing blocks it
+    std::vector<float> m_x, m_y;        // shown position
+    std::vector<float> m_minX, m_minY, m_maxX, m_maxY; // candidate boxes
+    std::vector<std::uint8_t> m_moved, m_blocked;
+    std::vector<std::uint32_t> m_slot;  // AnimationBatch instance
+
+    AnimationBatch m_batch;
+    sf::Color m_tint = sf::Color::White;
+};
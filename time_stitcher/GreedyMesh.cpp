@@ -0,0 +1,21 @@
+#include "GreedyMesh.h"
+#include <bit>
+
+void meshing::greedyRects(std::span<std::uint64_t> rows, std::vector<sf::IntRect>& out, sf::Vector2i origin) {
+    const int height = static_cast<int>(rows.size());
+    for (int y = 0; y < height; ++y) {
+        while (rows[y]) {
+            const int x = std::countr_zero(rows[y]);
+            const int width = std::countr_one(rows[y] >> x);
+            const std::uint64_t run = (width == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << width) - 1) << x;
+            rows[y] &= ~run;
+
+            int h = 1;
+            while (y + h < height and (rows[y + h] & run) == run) {
+                rows[y + h] &= ~run;
+                ++h;
+            }
+            out.push_back(sf::IntRect({ origin.x + x, origin.y + y }, { width, h }));
+        }
+    }
+}
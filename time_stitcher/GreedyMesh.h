@@ -0,0 +1,14 @@
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Merges the set bits of an occupancy bitmap into few axis aligned rectangles: each run of a
+// row is taken as wide as it goes, then grown downwards while the rows below have the same run
+// set. Not the minimum, but close to it for maze walls at a fraction of the cost.
+namespace meshing {
+    // rows: bit x of rows[y] = cell (x, y). The rows are consumed (cleared).
+    // Rectangles in cells, offset by `origin`, are appended to out.
+    void greedyRects(std::span<std::uint64_t> rows, std::vector<sf::IntRect>& out, sf::Vector2i origin = { 0, 0 });
+}
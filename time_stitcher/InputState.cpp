@@ -0,0 +1,82 @@
+#include "InputState.h"
+
+int InputState::index(sf::Keyboard::Key key) {
+    int i = static_cast<int>(key);
+    return i >= 0 and i < static_cast<int>(sf::Keyboard::KeyCount) ? i : -1;
+}
+
+void InputState::queue(sf::Keyboard::Key key, bool down) {
+    int i = index(key);
+    // key repeat sends KeyPressed again while held, only real transitions count
+    if (i < 0 or m_live[i] == down) return;
+    m_live[i] = down;
+    m_queue.push_back({ m_clock.getElapsedTime().asMicroseconds(), static_cast<std::uint16_t>(i), down });
+}
+
+void InputState::handle(const sf::Event& event) {
+    if (const auto* key = event.getIf<sf::Event::KeyPressed>())
+        queue(key->code, true);
+    else if (const auto* key = event.getIf<sf::Event::KeyReleased>())
+        queue(key->code, false);
+    else if (event.is<sf::Event::FocusLost>())
+        releaseAll(); // the release events would go to another window
+}
+
+void InputState::releaseAll() {
+    for (std::size_t i = 0; i < m_live.size(); ++i)
+        if (m_live[i]) queue(static_cast<sf::Keyboard::Key>(i), false);
+}
+
+void InputState::advanceTo(sf::Time time) {
+    m_pressed.reset();
+    m_released.reset();
+    const std::int64_t until = time.asMicroseconds();
+    std::size_t applied = 0;
+    if (m_oldestApplied < 0 and not m_queue.empty() and m_queue.front().time <= until)
+        m_oldestApplied = m_queue.front().time;
+    for (; applied < m_queue.size() and m_queue[applied].time <= until; ++applied) {
+        const Transition& t = m_queue[applied];
+        m_down[t.key] = t.down;
+        if (t.down) {
+            m_pressed[t.key] = true;
+            m_pressedAt[t.key] = t.time;
+        }
+        else {
+            m_released[t.key] = true;
+        }
+    }
+    m_queue.erase(m_queue.begin(), m_queue.begin() + static_cast<std::ptrdiff_t>(applied));
+}
+
+bool InputState::takeOldestApplied(sf::Time& time) {
+    if (m_oldestApplied < 0) return false;
+    time = sf::microseconds(m_oldestApplied);
+    m_oldestApplied = -1;
+    return true;
+}
+
+bool InputState::down(sf::Keyboard::Key key) const {
+    int i = index(key);
+    // a tap that started and ended within one tick still moves for that tick
+    return i >= 0 and (m_down[i] or m_pressed[i]);
+}
+
+bool InputState::pressed(sf::Keyboard::Key key) const {
+    int i = index(key);
+    return i >= 0 and m_pressed[i];
+}
+
+bool InputState::released(sf::Keyboard::Key key) const {
+    int i = index(key);
+    return i >= 0 and m_released[i];
+}
+
+sf::Time InputState::pressedAt(sf::Keyboard::Key key) const {
+    int i = index(key);
+    return i >= 0 ? sf::microseconds(m_pressedAt[i]) : sf::Time::Zero;
+}
+
+bool InputState::liveDown(sf::Keyboard::Key key) const {
+    int i = index(key);
+    return i >= 0 and m_live[i];
+}
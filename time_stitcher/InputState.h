@@ -0,0 +1,60 @@
+#pragma once
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/Keyboard.hpp>
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+// Keyboard state built from KeyPressed/KeyReleased events instead of polling the OS.
+// Every transition is timestamped when it is handled and queued; the fixed-step loop then
+// applies the transitions up to the end of each tick (advanceTo), so a key tapped between
+// two ticks of one frame lands on the right tick. The simulation only reads the tick state.
+class InputState {
+public:
+    // KeyPressed, KeyReleased and FocusLost (releases everything); other events are ignored
+    void handle(const sf::Event& event);
+
+    // time on the input clock, for advanceTo
+    sf::Time now() const { return m_clock.getElapsedTime(); }
+
+    // applies the queued transitions stamped at or before `time`
+    void advanceTo(sf::Time time);
+
+    // state as of the last advanceTo
+    bool down(sf::Keyboard::Key key) const;
+    // went down / up during the last advanceTo (a tap shorter than a tick shows in both)
+    bool pressed(sf::Keyboard::Key key) const;
+    bool released(sf::Keyboard::Key key) const;
+    // when the key last went down, on the input clock
+    sf::Time pressedAt(sf::Keyboard::Key key) const;
+
+    // state as of the last handled event, ahead of the simulation
+    bool liveDown(sf::Keyboard::Key key) const;
+
+    void releaseAll();
+
+    // stamp of the oldest transition applied since the last call, for the input latency
+    bool takeOldestApplied(sf::Time& time);
+
+private:
+    using Keys = std::bitset<sf::Keyboard::KeyCount>;
+    static int index(sf::Keyboard::Key key);
+    void queue(sf::Keyboard::Key key, bool down);
+
+    struct Transition {
+        std::int64_t time;  // microseconds on m_clock
+        std::uint16_t key;
+        bool down;
+    };
+
+    sf::Clock m_clock;
+    std::vector<Transition> m_queue; // in time order
+    Keys m_live;
+    Keys m_down;
+    Keys m_pressed;
+    Keys m_released;
+    std::int64_t m_pressedAt[sf::Keyboard::KeyCount] = {};
+    std::int64_t m_oldestApplied = -1;
+};
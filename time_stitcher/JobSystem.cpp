@@ -0,0 +1,93 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+JobSystem::JobSystem(unsigned threads) {
+    if (threads == 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        threads = std::max(1u, hw > 1 ? hw - 1 : 1u);
+    }
+    m_workers.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i)
+        m_workers.emplace_back([this] { workerLoop(); });
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        // pending jobs are dropped, only the running ones are finished
+        m_queue.clear();
+    }
+    m_cv.notify_all();
+    for (auto& t : m_workers) t.join();
+}
+
+void JobSystem::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(job));
+    }
+    m_cv.notify_one();
+}
+
+void JobSystem::submitUrgent(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_front(std::move(job));
+    }
+    m_cv.notify_one();
+}
+
+void JobSystem::parallelFor(std::size_t count, std::size_t grain, const std::function<void(std::size_t, std::size_t)>& body) {
+    if (count == 0) return;
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t slices = (count + grain - 1) / grain;
+    if (slices == 1) {
+        body(0, count);
+        return;
+    }
+    // shared with the helper jobs: one that starts after everything is done finds no slice
+    // left and returns without touching body
+    struct Shared {
+        std::atomic<std::size_t> next{ 0 };
+        std::atomic<std::size_t> done{ 0 };
+        std::size_t count = 0;
+        std::size_t grain = 0;
+        const std::function<void(std::size_t, std::size_t)>* body = nullptr;
+    };
+    auto shared = std::make_shared<Shared>();
+    shared->count = count;
+    shared->grain = grain;
+    shared->body = &body;
+    auto work = [](Shared& s) {
+        for (;;) {
+            const std::size_t begin = s.next.fetch_add(s.grain, std::memory_order_relaxed);
+            if (begin >= s.count) return;
+            const std::size_t end = std::min(begin + s.grain, s.count);
+            (*s.body)(begin, end);
+            s.done.fetch_add(end - begin, std::memory_order_release);
+        }
+    };
+    const std::size_t helpers = std::min<std::size_t>(workerCount(), slices - 1);
+    for (std::size_t i = 0; i < helpers; ++i)
+        submit([shared, work] { work(*shared); });
+    work(*shared);
+    // only slices a worker already started are left
+    while (shared->done.load(std::memory_order_acquire) < count) std::this_thread::yield();
+}
+
+void JobSystem::workerLoop() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_stop or not m_queue.empty(); });
+            if (m_stop) return;
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        job();
+    }
+}
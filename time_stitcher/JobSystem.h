@@ -0,0 +1,37 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads consuming a FIFO of jobs.
+// Used for work that must not block the frame (chunk generation, ...).
+class JobSystem {
+public:
+    // threads = 0: hardware_concurrency - 1 (at least one worker)
+    explicit JobSystem(unsigned threads = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void submit(std::function<void()> job);
+    // ahead of everything queued, for short jobs with a deadline
+    void submitUrgent(std::function<void()> job);
+    // body(begin, end) over [0, count) in slices of `grain`, on the workers and the calling
+    // thread; returns when all slices are done. The caller takes slices too, so a worker busy
+    // with a long job only means fewer helpers, never waiting for it.
+    void parallelFor(std::size_t count, std::size_t grain, const std::function<void(std::size_t, std::size_t)>& body);
+    unsigned workerCount() const { return static_cast<unsigned>(m_workers.size()); }
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stop = false;
+};
@@ -0,0 +1,199 @@
+#include "Lighting.h"
+#include "MemoryTracker.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    constexpr int FalloffSegments = 32;
+
+    sf::Vector2u texelsFor(sf::Vector2f size, float texelsPerUnit) {
+        return { static_cast<unsigned>(std::ceil(size.x * texelsPerUnit)), static_cast<unsigned>(std::ceil(size.y * texelsPerUnit)) };
+    }
+
+    void quad(sf::VertexArray& out, sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Vector2f d) {
+        const sf::Color shadow = sf::Color::Black;
+        out.append({ a, shadow });
+        out.append({ b, shadow });
+        out.append({ c, shadow });
+        out.append({ a, shadow });
+        out.append({ c, shadow });
+        out.append({ d, shadow });
+    }
+}
+
+Lighting::LightId Lighting::add(sf::Vector2f position, float radius, sf::Color color) {
+    LightId id;
+    if (not m_free.empty()) {
+        id = m_free.back();
+        m_free.pop_back();
+    }
+    else {
+        id = static_cast<LightId>(m_lights.size());
+        m_lights.emplace_back();
+    }
+    Light& light = m_lights[id];
+    light.position = position;
+    light.color = color;
+    light.alive = true;
+    light.dirty = true;
+    // the texture is reused when the slot gets a light of the same size
+    if (light.radius != radius) light.texture.reset();
+    light.radius = radius;
+    return id;
+}
+
+void Lighting::remove(LightId id) {
+    if (id >= m_lights.size() or not m_lights[id].alive) return;
+    m_lights[id].alive = false;
+    m_lights[id].shadows.clear();
+    m_free.push_back(id);
+}
+
+void Lighting::move(LightId id, sf::Vector2f position) {
+    if (id >= m_lights.size() or not m_lights[id].alive) return;
+    Light& light = m_lights[id];
+    if (light.position == position) return;
+    light.position = position;
+    light.dirty = true;
+}
+
+void Lighting::clear() {
+    m_free.clear();
+    for (LightId id = static_cast<LightId>(m_lights.size()); id-- > 0;) {
+        m_lights[id].alive = false;
+        m_lights[id].shadows.clear();
+        m_free.push_back(id); // lowest ids are handed out first
+    }
+}
+
+sf::FloatRect Lighting::bounds(const Light& light) const {
+    return { light.position - sf::Vector2f(light.radius, light.radius), { 2.f * light.radius, 2.f * light.radius } };
+}
+
+bool Lighting::buildShadows(Light& light, const ChunkWorld& world, std::pmr::memory_resource* scratch) const {
+    light.shadows.clear();
+    const sf::FloatRect area = bounds(light);
+    std::pmr::vector<sf::FloatRect> walls(scratch);
+    const bool complete = world.overlappingWalls(area, walls);
+
+    // far enough that the far side of an extruded edge stays outside the light's square even
+    // for an edge seen at almost 180 degrees; edges are clipped to the square first
+    const float extrude = light.radius * 64.f;
+    const sf::Vector2f lo = area.position, hi = area.position + area.size;
+    const sf::Vector2f l = light.position;
+    auto clamp = [&](sf::Vector2f p) { return sf::Vector2f(std::clamp(p.x, lo.x, hi.x), std::clamp(p.y, lo.y, hi.y)); };
+    auto away = [&](sf::Vector2f p) {
+        const sf::Vector2f d = p - l;
+        const float len = std::sqrt(d.x * d.x + d.y * d.y);
+        return len > 0.f ? p + d * (extrude / len) : p;
+    };
+    for (const sf::FloatRect& wall : walls) {
+        const sf::Vector2f a = wall.position, b = wall.position + wall.size;
+        // a light inside a wall sees nothing; the rectangle shadows everything around it
+        if (l.x > a.x and l.x < b.x and l.y > a.y and l.y < b.y) {
+            quad(light.shadows, lo, { hi.x, lo.y }, hi, { lo.x, hi.y });
+            continue;
+        }
+        // the edges the light is behind (inside of their line): everything beyond them is in
+        // shadow, while the wall itself stays lit
+        const sf::Vector2f edges[4][2] = {
+            { { a.x, a.y }, { a.x, b.y } }, { { b.x, a.y }, { b.x, b.y } },
+            { { a.x, a.y }, { b.x, a.y } }, { { a.x, b.y }, { b.x, b.y } },
+        };
+        const bool behind[4] = { l.x > a.x, l.x < b.x, l.y > a.y, l.y < b.y };
+        for (int i = 0; i < 4; ++i) {
+            if (not behind[i]) continue;
+            const sf::Vector2f p = clamp(edges[i][0]), q = clamp(edges[i][1]);
+            quad(light.shadows, p, q, away(q), away(p));
+        }
+    }
+    return complete;
+}
+
+void Lighting::bake(Light& light) {
+    const sf::FloatRect area = bounds(light);
+    const sf::Vector2u size = texelsFor(area.size, m_texelsPerUnit);
+    if (not light.texture or light.texture->getSize() != size) {
+        memory::Scope tag(memory::Tag::Rendering);
+        light.texture.emplace();
+        if (not light.texture->resize(size)) {
+            std::cerr << "Failed to create a " << size.x << "x" << size.y << " light texture\n";
+            light.texture.reset();
+            return;
+        }
+        light.texture->setSmooth(true);
+    }
+
+    // falloff from the light's colour in the centre to nothing at the radius
+    m_falloff.resize(FalloffSegments + 2);
+    m_falloff[0] = { light.position, light.color };
+    for (int i = 0; i <= FalloffSegments; ++i) {
+        const float angle = 6.2831853f * i / FalloffSegments;
+        m_falloff[i + 1] = { light.position + sf::Vector2f(std::cos(angle), std::sin(angle)) * light.radius, sf::Color::Black };
+    }
+    // whole texels, the same scale the light map uses
+    sf::RenderTexture& texture = *light.texture;
+    texture.setView(sf::View(sf::FloatRect(area.position, sf::Vector2f(size) / m_texelsPerUnit)));
+    texture.clear(sf::Color::Black);
+    texture.draw(m_falloff);
+    texture.draw(light.shadows);
+    texture.display();
+}
+
+void Lighting::update(const ChunkWorld& world, const sf::FloatRect& visible, std::pmr::memory_resource* scratch) {
+    m_baked = 0;
+    for (Light& light : m_lights) {
+        if (not light.alive or not light.dirty or not bounds(light).findIntersection(visible)) continue;
+        // walls that aren't streamed in yet get another try next frame
+        light.dirty = not buildShadows(light, world, scratch);
+        bake(light);
+        ++m_baked;
+    }
+}
+
+void Lighting::draw(sf::RenderTarget& target, const sf::View& view) {
+    // the light map covers the view on whole texels of the world, so it doesn't crawl when
+    // the camera moves by less than a texel
+    const float texel = 1.f / m_texelsPerUnit;
+    const sf::Vector2f viewPos = view.getCenter() - view.getSize() * 0.5f;
+    const sf::Vector2f origin(std::floor(viewPos.x / texel) * texel, std::floor(viewPos.y / texel) * texel);
+    const sf::Vector2u size = texelsFor(view.getSize(), m_texelsPerUnit) + sf::Vector2u(1, 1);
+    if (not m_lightmap or m_lightmap->getSize() != size) {
+        memory::Scope tag(memory::Tag::Rendering);
+        m_lightmap.emplace();
+        if (not m_lightmap->resize(size)) {
+            std::cerr << "Failed to create the light map, lighting is off\n";
+            m_lightmap.reset();
+            return;
+        }
+        m_lightmap->setSmooth(true);
+    }
+    const sf::FloatRect covered(origin, sf::Vector2f(size) * texel);
+
+    m_lightmap->setView(sf::View(covered));
+    m_lightmap->clear(m_ambient);
+    for (const Light& light : m_lights) {
+        if (not light.alive or not light.texture) continue;
+        const sf::FloatRect area = bounds(light);
+        if (not area.findIntersection(covered)) continue;
+        sf::Sprite sprite(light.texture->getTexture());
+        sprite.setPosition(area.position);
+        sprite.setScale({ texel, texel });
+        m_lightmap->draw(sprite, sf::RenderStates(sf::BlendAdd));
+    }
+    m_lightmap->display();
+
+    sf::Sprite lightmap(m_lightmap->getTexture());
+    lightmap.setPosition(origin);
+    lightmap.setScale({ texel, texel });
+    target.setView(view);
+    target.draw(lightmap, sf::RenderStates(sf::BlendMultiply));
+}
+
+std::size_t Lighting::textureBytes() const {
+    std::size_t total = m_lightmap ? memory::textureBytes(m_lightmap->getTexture()) : 0;
+    for (const Light& light : m_lights)
+        if (light.texture) total += memory::textureBytes(light.texture->getTexture());
+    return total;
+}
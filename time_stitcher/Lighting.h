@@ -0,0 +1,65 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+#include "ChunkWorld.h"
+
+// Point lights with shadows cast by the maze walls, multiplied over the finished frame.
+// For every light the merged wall rectangles within its radius are turned into shadow volumes
+// (the back-facing edges of each rectangle extruded away from the light) and baked together
+// with the light's falloff into a small texture of its own. That is kept until the light moves
+// or more of the maze streams in around it, so a static light costs one textured quad per frame.
+// The lights are added into a low resolution light map that starts at the ambient colour.
+class Lighting {
+public:
+    using LightId = std::uint32_t;
+    static constexpr LightId NoLight = 0xFFFFFFFFu;
+
+    // resolution of the light map and of the light textures
+    explicit Lighting(float texelsPerUnit = 0.25f) : m_texelsPerUnit(texelsPerUnit) {}
+
+    void setAmbient(sf::Color ambient) { m_ambient = ambient; }
+
+    LightId add(sf::Vector2f position, float radius, sf::Color color);
+    // the light's texture is kept for the next add(); NoLight is ignored
+    void remove(LightId id);
+    // re-bakes the light on the next update if the position changed
+    void move(LightId id, sf::Vector2f position);
+    void clear();
+
+    // re-bakes the changed lights that reach into `visible`; lights out of view wait until they
+    // are seen again (scratch backs the wall queries)
+    void update(const ChunkWorld& world, const sf::FloatRect& visible, std::pmr::memory_resource* scratch);
+    // the light map for `view`, multiplied over what target already shows
+    void draw(sf::RenderTarget& target, const sf::View& view);
+
+    std::size_t lightCount() const { return m_lights.size() - m_free.size(); }
+    std::size_t bakedLastUpdate() const { return m_baked; }
+    std::size_t textureBytes() const;
+
+private:
+    struct Light {
+        sf::Vector2f position;
+        float radius = 0.f;
+        sf::Color color;
+        bool alive = false;
+        bool dirty = true;   // shadows and texture are out of date
+        sf::VertexArray shadows{ sf::PrimitiveType::Triangles }; // in world units
+        std::optional<sf::RenderTexture> texture;
+    };
+
+    sf::FloatRect bounds(const Light& light) const;
+    // false if some of the walls weren't loaded yet; the light stays dirty then
+    bool buildShadows(Light& light, const ChunkWorld& world, std::pmr::memory_resource* scratch) const;
+    void bake(Light& light);
+
+    float m_texelsPerUnit;
+    sf::Color m_ambient{ 60, 60, 80 };
+    std::vector<Light> m_lights;  // LightId is the index
+    std::vector<LightId> m_free;
+    sf::VertexArray m_falloff{ sf::PrimitiveType::TriangleFan };
+    std::optional<sf::RenderTexture> m_lightmap;
+    std::size_t m_baked = 0;
+};
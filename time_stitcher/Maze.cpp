@@ -0,0 +1,70 @@
+#include "Maze.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // small integer hash (murmur3 finalizer), good enough to pick a carve direction
+    std::uint32_t hashCell(std::uint32_t seed, int cx, int cy) {
+        std::uint32_t h = seed ^ (static_cast<std::uint32_t>(cx) * 0x9E3779B1u) ^ (static_cast<std::uint32_t>(cy) * 0x85EBCA77u);
+        h ^= h >> 16;
+        h *= 0x85EBCA6Bu;
+        h ^= h >> 13;
+        h *= 0xC2B2AE35u;
+        h ^= h >> 16;
+        return h;
+    }
+}
+
+Maze::Maze(std::uint32_t seed, int widthTiles, int heightTiles)
+    : m_seed(seed),
+    m_width(std::max(3, widthTiles | 1)),
+    m_height(std::max(3, heightTiles | 1)),
+    m_cellsX((m_width - 1) / 2),
+    m_cellsY((m_height - 1) / 2)
+{
+}
+
+bool Maze::carvesNorth(int cx, int cy) const {
+    // top row can only go east, last column can only go north
+    if (cy == 0) return false;
+    if (cx == m_cellsX - 1) return true;
+    return (hashCell(m_seed, cx, cy) & 1u) != 0;
+}
+
+bool Maze::isWall(int tx, int ty) const {
+    if (not inside(tx, ty)) return true;
+    if (tx == 0 or ty == 0 or tx == m_width - 1 or ty == m_height - 1) return true;
+
+    bool oddX = (tx & 1) != 0;
+    bool oddY = (ty & 1) != 0;
+    if (oddX and oddY) return false;        // cell
+    if (not oddX and not oddY) return true; // pillar
+
+    if (oddX) {
+        // vertical passage between cell above and cell below: open if the lower one carved north
+        int cx = tx / 2, cy = ty / 2;
+        return not carvesNorth(cx, cy);
+    }
+    // horizontal passage between left and right cell: open if the left one carved east
+    int cx = (tx - 1) / 2, cy = ty / 2;
+    return carvesNorth(cx, cy);
+}
+
+sf::Vector2i Maze::tileAt(const sf::Vector2f& worldPos) const {
+    return { static_cast<int>(std::floor(worldPos.x / TileSize)),
+             static_cast<int>(std::floor(worldPos.y / TileSize)) };
+}
+
+sf::Vector2f Maze::tileCenter(const sf::Vector2i& tile) const {
+    return { (tile.x + 0.5f) * TileSize, (tile.y + 0.5f) * TileSize };
+}
+
+sf::Vector2i Maze::nearestCell(const sf::Vector2i& tile) const {
+    int cx = std::clamp((tile.x - 1) / 2, 0, m_cellsX - 1);
+    int cy = std::clamp((tile.y - 1) / 2, 0, m_cellsY - 1);
+    return { cx * 2 + 1, cy * 2 + 1 };
+}
+
+sf::FloatRect Maze::bounds() const {
+    return sf::FloatRect({ 0.f, 0.f }, { m_width * TileSize, m_height * TileSize });
+}
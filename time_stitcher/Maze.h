@@ -0,0 +1,41 @@
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+
+// Procedural "binary tree" maze.
+// Cells sit on odd tile coordinates, every cell carves a passage either north or east.
+// Each tile can be answered on its own from (seed, x, y), so any region of the maze
+// can be generated independently (e.g. chunk by chunk on worker threads) and the
+// whole maze never has to be held in memory.
+class Maze {
+public:
+    // world size of one tile in pixels
+    static constexpr float TileSize = 80.f;
+
+    // width/height are in tiles and get rounded up to odd numbers (walls on the border)
+    Maze(std::uint32_t seed = 1, int widthTiles = 1023, int heightTiles = 1023);
+
+    bool isWall(int tx, int ty) const;
+    bool inside(int tx, int ty) const { return tx >= 0 and ty >= 0 and tx < m_width and ty < m_height; }
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    std::uint32_t seed() const { return m_seed; }
+
+    sf::Vector2i tileAt(const sf::Vector2f& worldPos) const;
+    sf::Vector2f tileCenter(const sf::Vector2i& tile) const;
+    // snaps a tile to the nearest cell (always open)
+    sf::Vector2i nearestCell(const sf::Vector2i& tile) const;
+    sf::FloatRect bounds() const;
+
+private:
+    // true: cell (cx, cy) carves towards north, false: towards east
+    bool carvesNorth(int cx, int cy) const;
+
+    std::uint32_t m_seed;
+    int m_width;
+    int m_height;
+    int m_cellsX;
+    int m_cellsY;
+};
@@ -0,0 +1,249 @@
+#include "MemoryTracker.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+namespace {
+    constexpr std::size_t TagCount = static_cast<std::size_t>(memory::Tag::Count);
+
+    // plain arrays of atomics: usable before any constructor runs (static init order)
+    std::atomic<std::int64_t> g_live[TagCount];
+    std::atomic<std::uint64_t> g_allocs[TagCount];
+    std::atomic<std::int64_t> g_liveTotal{ 0 };
+    std::atomic<std::int64_t> g_peak{ 0 };
+    std::atomic<std::uint64_t> g_allocTotal{ 0 };
+
+    std::uint64_t g_frameStart = 0;
+    std::uint64_t g_frameAllocs = 0;
+    std::uint64_t g_maxFrameAllocs = 0;
+
+    thread_local memory::Tag t_tag = memory::Tag::Untagged;
+
+    // Blocks are plain malloc blocks, nothing is stored next to them: the SFML DLLs have their
+    // own operator new/delete but share the CRT heap, so a block allocated on one side and
+    // freed on the other must stay a valid malloc block. Size and tag of the blocks allocated
+    // here live in a side table instead (open addressing, sharded by address to keep the locks
+    // short, grown with malloc so it never recurses into operator new). Blocks freed by a DLL
+    // leave a stale entry; it is settled when the address comes back from malloc.
+    struct Entry {
+        void* block;        // nullptr: empty, Tombstone: erased
+        std::size_t size;
+        std::uint32_t tag;
+    };
+    void* const Tombstone = reinterpret_cast<void*>(1);
+
+    struct Shard {
+        std::mutex mutex;
+        Entry* entries = nullptr;
+        std::size_t capacity = 0; // power of two
+        std::size_t used = 0;     // live entries and tombstones
+    };
+    constexpr std::size_t ShardCount = 64;
+    Shard g_shards[ShardCount];
+
+    std::size_t hashOf(const void* block) {
+        return static_cast<std::size_t>((reinterpret_cast<std::uintptr_t>(block) >> 4) * 0x9E3779B97F4A7C15ull >> 16);
+    }
+
+    void release(const Entry& entry) {
+        g_live[entry.tag].fetch_sub(static_cast<std::int64_t>(entry.size), std::memory_order_relaxed);
+        g_liveTotal.fetch_sub(static_cast<std::int64_t>(entry.size), std::memory_order_relaxed);
+    }
+
+    // false if the table couldn't grow; the block then goes untracked
+    bool grow(Shard& shard) {
+        const std::size_t capacity = shard.capacity ? shard.capacity * 2 : 1024;
+        auto* entries = static_cast<Entry*>(std::calloc(capacity, sizeof(Entry)));
+        if (not entries) return false;
+        for (std::size_t i = 0; i < shard.capacity; ++i) {
+            const Entry& e = shard.entries[i];
+            if (e.block == nullptr or e.block == Tombstone) continue;
+            std::size_t slot = hashOf(e.block) & (capacity - 1);
+            while (entries[slot].block) slot = (slot + 1) & (capacity - 1);
+            entries[slot] = e;
+        }
+        std::free(shard.entries);
+        shard.entries = entries;
+        shard.used = 0;
+        for (std::size_t i = 0; i < capacity; ++i) shard.used += entries[i].block != nullptr;
+        shard.capacity = capacity;
+        return true;
+    }
+
+    bool remember(void* block, std::size_t size, std::uint32_t tag) {
+        const std::size_t hash = hashOf(block);
+        Shard& shard = g_shards[hash % ShardCount];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if ((shard.used + 1) * 4 > shard.capacity * 3 and not grow(shard)) return false;
+        const std::size_t mask = shard.capacity - 1;
+        Entry* free = nullptr;
+        for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            Entry& e = shard.entries[slot];
+            if (e.block == block) {
+                // freed by a DLL since, its bytes are no longer live
+                release(e);
+                free = &e;
+                break;
+            }
+            if (e.block == Tombstone) {
+                if (not free) free = &e;
+                continue;
+            }
+            if (e.block == nullptr) {
+                if (not free) {
+                    free = &e;
+                    ++shard.used;
+                }
+                break;
+            }
+        }
+        *free = { block, size, tag };
+        return true;
+    }
+
+    // false if the block isn't ours (allocated by a DLL)
+    bool forget(void* block, Entry& out) {
+        const std::size_t hash = hashOf(block);
+        Shard& shard = g_shards[hash % ShardCount];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.capacity == 0) return false;
+        const std::size_t mask = shard.capacity - 1;
+        for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            Entry& e = shard.entries[slot];
+            if (e.block == nullptr) return false;
+            if (e.block == block) {
+                out = e;
+                e.block = Tombstone;
+                return true;
+            }
+        }
+    }
+
+    // over-aligned blocks come from the CRT's aligned allocator, like the DLLs' aligned new
+    void* rawAlloc(std::size_t size, std::size_t alignment) {
+        if (size == 0) size = 1;
+        if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) return std::malloc(size);
+#ifdef _WIN32
+        return _aligned_malloc(size, alignment);
+#else
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+    }
+
+    void rawFree(void* p, bool aligned) {
+#ifdef _WIN32
+        if (aligned) {
+            _aligned_free(p);
+            return;
+        }
+#endif
+        (void)aligned;
+        std::free(p);
+    }
+
+    bool overAligned(std::align_val_t al) {
+        return static_cast<std::size_t>(al) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    }
+
+    void* trackedAlloc(std::size_t size, std::size_t alignment) {
+        void* block = rawAlloc(size, alignment);
+        if (not block) return nullptr;
+        const auto tag = static_cast<std::uint32_t>(t_tag);
+        if (not remember(block, size, tag)) return block;
+
+        g_live[tag].fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+        g_allocs[tag].fetch_add(1, std::memory_order_relaxed);
+        g_allocTotal.fetch_add(1, std::memory_order_relaxed);
+        std::int64_t total = g_liveTotal.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed) + static_cast<std::int64_t>(size);
+        std::int64_t peak = g_peak.load(std::memory_order_relaxed);
+        while (total > peak and not g_peak.compare_exchange_weak(peak, total, std::memory_order_relaxed)) {}
+        return block;
+    }
+
+    void trackedFree(void* p, bool aligned = false) {
+        if (not p) return;
+        Entry entry;
+        if (forget(p, entry)) release(entry);
+        rawFree(p, aligned);
+    }
+
+    void* allocOrThrow(std::size_t size, std::size_t alignment) {
+        if (void* p = trackedAlloc(size, alignment)) return p;
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new(std::size_t size) { return allocOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](std::size_t size) { return allocOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(std::size_t size, std::align_val_t al) { return allocOrThrow(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al) { return allocOrThrow(size, static_cast<std::size_t>(al)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return trackedAlloc(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return trackedAlloc(size, static_cast<std::size_t>(al)); }
+
+void operator delete(void* p) noexcept { trackedFree(p); }
+void operator delete[](void* p) noexcept { trackedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { trackedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { trackedFree(p); }
+void operator delete(void* p, std::align_val_t al) noexcept { trackedFree(p, overAligned(al)); }
+void operator delete[](void* p, std::align_val_t al) noexcept { trackedFree(p, overAligned(al)); }
+void operator delete(void* p, std::size_t, std::align_val_t al) noexcept { trackedFree(p, overAligned(al)); }
+void operator delete[](void* p, std::size_t, std::align_val_t al) noexcept { trackedFree(p, overAligned(al)); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { trackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { trackedFree(p); }
+void operator delete(void* p, std::align_val_t al, const std::nothrow_t&) noexcept { trackedFree(p, overAligned(al)); }
+void operator delete[](void* p, std::align_val_t al, const std::nothrow_t&) noexcept { trackedFree(p, overAligned(al)); }
+
+const char* memory::tagName(Tag tag) {
+    switch (tag) {
+    case Tag::Untagged:   return "untagged";
+    case Tag::Assets:     return "assets";
+    case Tag::Simulation: return "simulation";
+    case Tag::Rendering:  return "rendering";
+    case Tag::Streaming:  return "streaming";
+    default:              return "?";
+    }
+}
+
+memory::Scope::Scope(Tag tag) : m_previous(t_tag) {
+    t_tag = tag;
+}
+
+memory::Scope::~Scope() {
+    t_tag = m_previous;
+}
+
+std::int64_t memory::liveBytes(Tag tag) { return g_live[static_cast<std::size_t>(tag)].load(std::memory_order_relaxed); }
+std::int64_t memory::liveBytes() { return g_liveTotal.load(std::memory_order_relaxed); }
+std::int64_t memory::peakBytes() { return g_peak.load(std::memory_order_relaxed); }
+std::uint64_t memory::allocations(Tag tag) { return g_allocs[static_cast<std::size_t>(tag)].load(std::memory_order_relaxed); }
+std::uint64_t memory::allocations() { return g_allocTotal.load(std::memory_order_relaxed); }
+
+void memory::endFrame() {
+    std::uint64_t now = allocations();
+    g_frameAllocs = now - g_frameStart;
+    g_frameStart = now;
+    if (g_frameAllocs > g_maxFrameAllocs) g_maxFrameAllocs = g_frameAllocs;
+}
+
+std::uint64_t memory::frameAllocations() { return g_frameAllocs; }
+std::uint64_t memory::maxFrameAllocations() { return g_maxFrameAllocs; }
+
+std::size_t memory::textureBytes(const sf::Texture& texture) {
+    sf::Vector2u size = texture.getSize();
+    return static_cast<std::size_t>(size.x) * size.y * 4;
+}
+
+void memory::dump(std::ostream& out, std::size_t gpuBytes) {
+    out << "Memory:\n";
+    for (std::size_t i = 0; i < TagCount; ++i) {
+        Tag tag = static_cast<Tag>(i);
+        out << "  " << tagName(tag) << ": " << liveBytes(tag) << " bytes live, " << allocations(tag) << " allocations\n";
+    }
+    out << "  heap: " << liveBytes() << " bytes live, peak " << peakBytes() << ", " << allocations() << " allocations\n";
+    out << "  allocations per frame: last " << frameAllocations() << ", max " << maxFrameAllocations() << '\n';
+    out << "  textures (estimated gpu): " << gpuBytes << " bytes\n";
+}
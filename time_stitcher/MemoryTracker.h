@@ -0,0 +1,50 @@
+#pragma once
+#include <SFML/Graphics/Texture.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+// Heap accounting. MemoryTracker.cpp replaces the global operator new/delete: every allocation
+// is attributed to the tag of the innermost memory::Scope on the allocating thread and counted,
+// so we can see live bytes per subsystem and how many allocations each frame does.
+namespace memory {
+    enum class Tag : std::uint8_t {
+        Untagged,
+        Assets,
+        Simulation,
+        Rendering,
+        Streaming,
+        Count
+    };
+
+    const char* tagName(Tag tag);
+
+    // attributes allocations made on this thread to `tag` while alive
+    class Scope {
+    public:
+        explicit Scope(Tag tag);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Tag m_previous;
+    };
+
+    std::int64_t liveBytes(Tag tag);
+    std::int64_t liveBytes();       // all tags
+    std::int64_t peakBytes();
+    std::uint64_t allocations(Tag tag);
+    std::uint64_t allocations();    // all tags, since startup
+
+    // closes the current frame; frameAllocations() then reports the allocations it made
+    void endFrame();
+    std::uint64_t frameAllocations();
+    std::uint64_t maxFrameAllocations();
+
+    // estimated video memory of a texture (RGBA8, no mipmaps)
+    std::size_t textureBytes(const sf::Texture& texture);
+
+    void dump(std::ostream& out, std::size_t gpuBytes);
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Handle into an ObjectPool. The generation makes handles of released objects go stale
+// instead of silently pointing at whatever reuses the slot.
+struct PoolHandle {
+    static constexpr std::uint32_t Invalid = 0xFFFFFFFFu;
+
+    std::uint32_t index = Invalid;
+    std::uint32_t generation = 0;
+
+    bool valid() const { return index != Invalid; }
+    bool operator==(const PoolHandle& other) const { return index == other.index and generation == other.generation; }
+    bool operator!=(const PoolHandle& other) const { return not (*this == other); }
+};
+
+// Typed pool of recyclable objects with a free list.
+// Objects are default constructed once, in pages that never move (pointers stay valid for the
+// life of the pool), and are handed out again after release() without being destroyed, so any
+// memory they own (vectors, vertex arrays, ...) is reused. After warm-up, acquire/release
+// never allocate. The caller re-initializes an object after acquire().
+template <class T, std::size_t PageSize = 64>
+class ObjectPool {
+public:
+    explicit ObjectPool(std::size_t reserve = 0) {
+        while (capacity() < reserve) addPage();
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    PoolHandle acquire() {
+        if (m_freeHead == PoolHandle::Invalid) addPage();
+        std::uint32_t i = m_freeHead;
+        Meta& meta = m_meta[i];
+        m_freeHead = meta.nextFree;
+        meta.alive = true;
+        ++m_alive;
+        return { i, meta.generation };
+    }
+
+    void release(PoolHandle handle) {
+        if (not alive(handle)) return;
+        Meta& meta = m_meta[handle.index];
+        meta.alive = false;
+        ++meta.generation;
+        meta.nextFree = m_freeHead;
+        m_freeHead = handle.index;
+        --m_alive;
+    }
+
+    // releases every object at once, memory is kept
+    void reset() {
+        m_freeHead = PoolHandle::Invalid;
+        for (std::uint32_t i = static_cast<std::uint32_t>(m_meta.size()); i-- > 0;) {
+            Meta& meta = m_meta[i];
+            if (meta.alive) ++meta.generation;
+            meta.alive = false;
+            meta.nextFree = m_freeHead;
+            m_freeHead = i;
+        }
+        m_alive = 0;
+    }
+
+    bool alive(PoolHandle handle) const {
+        return handle.index < m_meta.size() and m_meta[handle.index].alive and m_meta[handle.index].generation == handle.generation;
+    }
+
+    T* get(PoolHandle handle) { return alive(handle) ? &at(handle.index) : nullptr; }
+    const T* get(PoolHandle handle) const { return alive(handle) ? &at(handle.index) : nullptr; }
+
+    // fn(PoolHandle, T&) for every live object
+    template <class Fn>
+    void forEach(Fn&& fn) {
+        for (std::uint32_t i = 0; i < m_meta.size(); ++i)
+            if (m_meta[i].alive) fn(PoolHandle{ i, m_meta[i].generation }, at(i));
+    }
+
+    std::size_t size() const { return m_alive; }
+    std::size_t capacity() const { return m_pages.size() * PageSize; }
+
+private:
+    struct Meta {
+        std::uint32_t generation = 0;
+        std::uint32_t nextFree = PoolHandle::Invalid;
+        bool alive = false;
+    };
+
+    T& at(std::uint32_t i) { return m_pages[i / PageSize][i % PageSize]; }
+    const T& at(std::uint32_t i) const { return m_pages[i / PageSize][i % PageSize]; }
+
+    void addPage() {
+        std::uint32_t base = static_cast<std::uint32_t>(capacity());
+        m_pages.push_back(std::make_unique<T[]>(PageSize));
+        m_meta.resize(base + PageSize);
+        // chain the new slots in index order in front of the free list
+        for (std::uint32_t i = base + PageSize; i-- > base;) {
+            m_meta[i].nextFree = m_freeHead;
+            m_freeHead = i;
+        }
+    }
+
+    std::vector<std::unique_ptr<T[]>> m_pages;
+    std::vector<Meta> m_meta;
+    std::uint32_t m_freeHead = PoolHandle::Invalid;
+    std::size_t m_alive = 0;
+};
@@ -1,8 +1,11 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cmath>
 #include <optional>
 #include <string>
 #include "time.h"
+#include "Simulation.h"
+#include "CollisionMask.h"
 
 using namespace sf;
 
@@ -10,24 +13,29 @@ class Obstacle {
 public:
 	RectangleShape m_shape;
 	std::optional<Sprite> m_sprite;
-	std::optional<Texture> m_texture;
+	// shared, owned by a TextureCache
+	const Texture* m_texture = nullptr;
+	// alpha mask of the texture for the narrow phase, also shared; none: the box is solid
+	const CollisionMask* m_mask = nullptr;
 
 	bool m_collidable = true;
 	bool m_didTouch = false;
 	Color m_fillColor = Color::White;
 
-	// touch timer in seconds (non-blocking)
-	float m_touchRemaining = 0.f;
+	// touch timer in simulation ticks (non-blocking); whole ticks keep it deterministic
+	static constexpr int TouchTicks = sim::TicksPerSecond / 10; // 100 ms
+	int m_touchTicks = 0;
 
-	Obstacle(const Vector2f& position, const std::string& texturePath = "NULL") {
-		if (not m_texture.emplace().loadFromFile(texturePath)) {
+	Obstacle(const Vector2f& position, const Texture* texture = nullptr, const CollisionMask* mask = nullptr) {
+		m_texture = texture;
+		m_mask = texture ? mask : nullptr;
+		if (not m_texture) {
 			m_shape.setPosition(position);
 			m_shape.setSize({ 32.f, 32.f });
 			m_fillColor = Color::Red;
 			m_shape.setFillColor(m_fillColor);
 		}
 		else {
-			m_texture->setSmooth(true);
 			m_sprite.emplace(*m_texture);
 			FloatRect bounds = m_sprite->getLocalBounds();
 			m_sprite->setOrigin({ bounds.size.x * 0.5f, bounds.size.y * 0.5f });
@@ -35,13 +43,10 @@ public:
 		}
 	}
 
-	bool setTextureFromFile(const std::string& texturePath) {
-		m_texture.emplace();
-		if (not m_texture->loadFromFile(texturePath)) {
-			m_texture.reset();
-			return false;
-		}
-		m_texture->setSmooth(true);
+	bool setTexture(const Texture* texture, const CollisionMask* mask = nullptr) {
+		if (not texture) return false;
+		m_texture = texture;
+		m_mask = mask;
 		m_sprite.emplace(*m_texture);
 		FloatRect bounds = m_sprite->getLocalBounds();
 		m_sprite->setOrigin({ bounds.size.x * 0.5f, bounds.size.y * 0.5f });
@@ -52,9 +57,15 @@ public:
 		return true;
 	}
 
-	void draw(RenderWindow& window) {
-		if (m_sprite) window.draw(*m_sprite);
-		else window.draw(m_shape);
+	void draw(RenderTarget& target) {
+		if (m_sprite) target.draw(*m_sprite);
+		else target.draw(m_shape);
+	}
+
+	// the position it was created with
+	Vector2f getPosition() const {
+		if (m_sprite) return m_sprite->getPosition();
+		return m_shape.getPosition();
 	}
 
 	FloatRect getBounds() const {
@@ -65,7 +76,7 @@ public:
 	// Non-blocking: start brief "touched" visual state
 	void touched() {
 		if (m_didTouch) return;
-		m_touchRemaining = 0.1f; // 100 ms
+		m_touchTicks = TouchTicks;
 		m_didTouch = true;
 		if (m_sprite) {
 			m_sprite->setColor(Color::Yellow);
@@ -75,11 +86,10 @@ public:
 		}
 	}
 
-	// Called each frame from main loop with dt (seconds)
-	void update(float dt) {
-		if (m_touchRemaining <= 0.f) return;
-		m_touchRemaining -= dt;
-		if (m_touchRemaining <= 0.f) {
+	// Called once per simulation tick
+	void update() {
+		if (m_touchTicks <= 0) return;
+		if (--m_touchTicks == 0) {
 			// restore colors
 			printf("Obstacle: touch effect ended\n");
 			if (m_sprite) {
@@ -89,7 +99,6 @@ public:
 				m_shape.setFillColor(m_fillColor);
 			}
 			m_didTouch = false;
-			m_touchRemaining = 0.f;
 		}
 	}
 
@@ -109,4 +118,20 @@ public:
 		if (not m_collidable) return false;
 		return getBounds().findIntersection(other) != std::nullopt;
 	}
+
+	// narrow phase after intersects(): solid pixels of `mask` (placed at topLeft) against ours
+	bool overlaps(const CollisionMask& mask, Vector2i topLeft) const {
+		FloatRect b = getBounds();
+		Vector2i ours(static_cast<int>(std::lround(b.position.x)), static_cast<int>(std::lround(b.position.y)));
+		if (m_mask and m_sprite) return collision::overlaps(mask, topLeft, *m_mask, ours);
+		return collision::overlaps(mask, topLeft, IntRect(ours, Vector2i(b.size)));
+	}
+
+	// the same for a mover without a mask, solid over its whole box
+	bool overlaps(const IntRect& solid) const {
+		if (not m_mask or not m_sprite) return true;
+		FloatRect b = getBounds();
+		Vector2i ours(static_cast<int>(std::lround(b.position.x)), static_cast<int>(std::lround(b.position.y)));
+		return collision::overlaps(*m_mask, ours, solid);
+	}
 };
\ No newline at end of file
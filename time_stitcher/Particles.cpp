@@ -0,0 +1,158 @@
+#include "Particles.h"
+#include <algorithm>
+#include <cmath>
+
+ParticleSystem::ParticleSystem(std::size_t capacity)
+    : m_capacity(capacity),
+    m_x(capacity), m_y(capacity), m_vx(capacity), m_vy(capacity),
+    m_life(capacity), m_invLife(capacity), m_size(capacity), m_color(capacity),
+    m_emitters(MaxEmitters)
+{
+    m_freeEmitters.reserve(MaxEmitters);
+    for (EmitterId id = MaxEmitters; id-- > 0;) m_freeEmitters.push_back(id);
+    m_vertices.resize(capacity * 3);
+}
+
+float ParticleSystem::random(float lo, float hi) {
+    return lo + (hi - lo) * static_cast<float>(m_rng() - m_rng.min()) / static_cast<float>(m_rng.max() - m_rng.min());
+}
+
+void ParticleSystem::spawn(sf::Vector2f position, const ParticleEffect& effect, int count) {
+    const std::size_t n = std::min<std::size_t>(static_cast<std::size_t>(std::max(count, 0)), m_capacity - m_count);
+    for (std::size_t k = 0; k < n; ++k) {
+        const std::size_t i = m_count++;
+        const float angle = random(0.f, 6.2831853f);
+        const float speed = random(effect.speedMin, effect.speedMax);
+        const float life = random(effect.lifeMin, effect.lifeMax);
+        m_x[i] = position.x;
+        m_y[i] = position.y;
+        m_vx[i] = std::cos(angle) * speed;
+        m_vy[i] = std::sin(angle) * speed;
+        m_life[i] = life;
+        m_invLife[i] = life > 0.f ? 1.f / life : 0.f;
+        m_size[i] = effect.size;
+        m_color[i] = effect.color;
+    }
+}
+
+void ParticleSystem::burst(sf::Vector2f position, const ParticleEffect& effect) {
+    spawn(position, effect, effect.count);
+}
+
+ParticleSystem::EmitterId ParticleSystem::startEmitter(sf::Vector2f position, float duration, const ParticleEffect& effect) {
+    if (m_freeEmitters.empty()) return NoEmitter;
+    EmitterId id = m_freeEmitters.back();
+    m_freeEmitters.pop_back();
+    Emitter& emitter = m_emitters[id];
+    emitter.position = position;
+    emitter.remaining = duration;
+    emitter.owed = 0.f;
+    emitter.effect = effect;
+    emitter.alive = true;
+    return id;
+}
+
+void ParticleSystem::moveEmitter(EmitterId id, sf::Vector2f position) {
+    if (id < MaxEmitters and m_emitters[id].alive) m_emitters[id].position = position;
+}
+
+void ParticleSystem::stopEmitter(EmitterId id) {
+    if (id >= MaxEmitters or not m_emitters[id].alive) return;
+    m_emitters[id].alive = false;
+    m_freeEmitters.push_back(id);
+}
+
+void ParticleSystem::clear() {
+    m_count = 0;
+    for (EmitterId id = 0; id < MaxEmitters; ++id) stopEmitter(id);
+}
+
+template <class F>
+void ParticleSystem::slices(std::size_t count, F&& body) {
+    if (m_jobs and count > Grain) {
+        m_jobs->parallelFor(count, Grain, body);
+        return;
+    }
+    body(0, count);
+}
+
+void ParticleSystem::integrate(std::size_t begin, std::size_t end, float dt) {
+    const float keep = std::max(0.f, 1.f - m_drag * dt);
+    float* x = m_x.data();
+    float* y = m_y.data();
+    float* vx = m_vx.data();
+    float* vy = m_vy.data();
+    float* life = m_life.data();
+    // separate loops over plain float arrays, each one vectorizes
+    for (std::size_t i = begin; i < end; ++i) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+    }
+    for (std::size_t i = begin; i < end; ++i) {
+        vx[i] *= keep;
+        vy[i] *= keep;
+    }
+    for (std::size_t i = begin; i < end; ++i) life[i] -= dt;
+}
+
+void ParticleSystem::compact() {
+    // swap-remove: the last particle takes the place of a dead one, order doesn't matter
+    std::size_t i = 0;
+    while (i < m_count) {
+        if (m_life[i] > 0.f) {
+            ++i;
+            continue;
+        }
+        const std::size_t last = --m_count;
+        m_x[i] = m_x[last];
+        m_y[i] = m_y[last];
+        m_vx[i] = m_vx[last];
+        m_vy[i] = m_vy[last];
+        m_life[i] = m_life[last];
+        m_invLife[i] = m_invLife[last];
+        m_size[i] = m_size[last];
+        m_color[i] = m_color[last];
+    }
+}
+
+void ParticleSystem::update(float dt) {
+    for (EmitterId id = 0; id < MaxEmitters; ++id) {
+        Emitter& emitter = m_emitters[id];
+        if (not emitter.alive) continue;
+        const float active = std::min(dt, emitter.remaining);
+        emitter.owed += emitter.effect.count * active;
+        const int whole = static_cast<int>(emitter.owed);
+        emitter.owed -= static_cast<float>(whole);
+        spawn(emitter.position, emitter.effect, whole);
+        emitter.remaining -= dt;
+        if (emitter.remaining <= 0.f) stopEmitter(id);
+    }
+    slices(m_count, [this, dt](std::size_t begin, std::size_t end) { integrate(begin, end, dt); });
+    compact();
+}
+
+void ParticleSystem::mesh(std::size_t begin, std::size_t end) {
+    // one small triangle around each particle, fading with the life left; texture coordinates
+    // are never used, so only positions and colours are written
+    for (std::size_t i = begin; i < end; ++i) {
+        const float s = m_size[i];
+        const sf::Vector2f p(m_x[i], m_y[i]);
+        sf::Color c = m_color[i];
+        c.a = static_cast<std::uint8_t>(c.a * std::clamp(m_life[i] * m_invLife[i], 0.f, 1.f));
+        sf::Vertex* v = &m_vertices[i * 3];
+        v[0].position = p + sf::Vector2f(0.f, -s);
+        v[1].position = p + sf::Vector2f(0.866f * s, 0.5f * s);
+        v[2].position = p + sf::Vector2f(-0.866f * s, 0.5f * s);
+        v[0].color = v[1].color = v[2].color = c;
+    }
+}
+
+void ParticleSystem::buildVertices() {
+    slices(m_count, [this](std::size_t begin, std::size_t end) { mesh(begin, end); });
+}
+
+void ParticleSystem::draw(sf::RenderTarget& target) {
+    if (m_count == 0) return;
+    buildVertices();
+    target.draw(&m_vertices[0], m_count * 3, sf::PrimitiveType::Triangles);
+}
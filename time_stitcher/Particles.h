@@ -0,0 +1,87 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "JobSystem.h"
+
+// How a burst or an emitter spawns particles.
+struct ParticleEffect {
+    int count = 32;              // per burst, per second for an emitter
+    float speedMin = 40.f;       // world units per second, in a random direction
+    float speedMax = 160.f;
+    float lifeMin = 0.3f;        // seconds
+    float lifeMax = 0.8f;
+    float size = 4.f;
+    sf::Color color = sf::Color::White; // fades out over the life
+};
+
+// Purely visual particles, many of them. Every attribute has its own array (positions,
+// velocities, life, size, colour) so integration is a few straight loops the compiler
+// vectorizes; dead particles are swapped with the last one, the arrays stay dense. Emitters
+// live in a fixed pool allocated up front and the arrays are reserved for the capacity, so
+// nothing allocates while playing. Everything is drawn as one triangle per particle in a
+// single VertexArray. With a JobSystem large counts are integrated and meshed in slices.
+class ParticleSystem {
+public:
+    using EmitterId = std::uint32_t;
+    static constexpr EmitterId NoEmitter = 0xFFFFFFFFu;
+    static constexpr std::size_t MaxEmitters = 64;
+
+    explicit ParticleSystem(std::size_t capacity = 100000);
+
+    // optional: split update and draw over the workers once there are enough particles
+    void setJobs(JobSystem* jobs) { m_jobs = jobs; }
+    // fraction of the velocity lost per second
+    void setDrag(float drag) { m_drag = drag; }
+
+    // spawns effect.count particles at once; what doesn't fit in the capacity is dropped
+    void burst(sf::Vector2f position, const ParticleEffect& effect);
+    // spawns effect.count particles per second for `duration` seconds; NoEmitter if all
+    // emitters are in use
+    EmitterId startEmitter(sf::Vector2f position, float duration, const ParticleEffect& effect);
+    void moveEmitter(EmitterId id, sf::Vector2f position);
+    void stopEmitter(EmitterId id);
+    void clear();
+
+    void update(float dt);
+    void draw(sf::RenderTarget& target);
+
+    std::size_t size() const { return m_count; }
+    std::size_t capacity() const { return m_capacity; }
+
+private:
+    struct Emitter {
+        sf::Vector2f position;
+        float remaining = 0.f;   // seconds
+        float owed = 0.f;        // fractional particles carried to the next update
+        ParticleEffect effect;
+        bool alive = false;
+    };
+
+    static constexpr std::size_t Grain = 16384; // particles per job slice
+
+    void spawn(sf::Vector2f position, const ParticleEffect& effect, int count);
+    void integrate(std::size_t begin, std::size_t end, float dt);
+    void compact();
+    void mesh(std::size_t begin, std::size_t end);
+    void buildVertices();
+    float random(float lo, float hi);
+    template <class F>
+    void slices(std::size_t count, F&& body);
+
+    std::size_t m_capacity;
+    std::size_t m_count = 0;
+    std::vector<float> m_x, m_y, m_vx, m_vy;
+    std::vector<float> m_life, m_invLife; // seconds left, 1 / the life it started with
+    std::vector<float> m_size;
+    std::vector<sf::Color> m_color;
+
+    std::vector<Emitter> m_emitters;      // MaxEmitters, never resized
+    std::vector<EmitterId> m_freeEmitters;
+
+    float m_drag = 2.f;
+    std::minstd_rand m_rng{ 12345 };      // effects only, not part of the simulation state
+    JobSystem* m_jobs = nullptr;
+    sf::VertexArray m_vertices{ sf::PrimitiveType::Triangles };
+};
@@ -0,0 +1,246 @@
+#include "Pathfinder.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+    constexpr float Sqrt2 = 1.41421356f;
+
+    float octile(int dx, int dy) {
+        dx = std::abs(dx);
+        dy = std::abs(dy);
+        return static_cast<float>(std::max(dx, dy)) + (Sqrt2 - 1.f) * static_cast<float>(std::min(dx, dy));
+    }
+
+    int sign(int v) { return (v > 0) - (v < 0); }
+}
+
+Pathfinder::Pathfinder(const TileGrid& grid) {
+    rebind(grid);
+}
+
+void Pathfinder::rebind(const TileGrid& grid) {
+    m_grid = &grid;
+    m_width = grid.width();
+    m_height = grid.height();
+    std::size_t n = static_cast<std::size_t>(m_width) * m_height;
+    m_seen.assign(n, 0);
+    m_closed.assign(n, 0);
+    m_g.assign(n, 0.f);
+    m_parent.assign(n, -1);
+    m_heapPos.assign(n, -1);
+    m_heap.assign(n, HeapEntry{ 0.f, -1 });
+    m_generation = 0;
+}
+
+float Pathfinder::heuristic(int x, int y) const {
+    return octile(m_goalX - x, m_goalY - y);
+}
+
+void Pathfinder::siftUp(int pos) {
+    HeapEntry e = m_heap[pos];
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (m_heap[parent].f <= e.f) break;
+        m_heap[pos] = m_heap[parent];
+        m_heapPos[m_heap[pos].node] = pos;
+        pos = parent;
+    }
+    m_heap[pos] = e;
+    m_heapPos[e.node] = pos;
+}
+
+void Pathfinder::siftDown(int pos) {
+    HeapEntry e = m_heap[pos];
+    int size = static_cast<int>(m_heapSize);
+    for (;;) {
+        int child = pos * 2 + 1;
+        if (child >= size) break;
+        if (child + 1 < size and m_heap[child + 1].f < m_heap[child].f) ++child;
+        if (e.f <= m_heap[child].f) break;
+        m_heap[pos] = m_heap[child];
+        m_heapPos[m_heap[pos].node] = pos;
+        pos = child;
+    }
+    m_heap[pos] = e;
+    m_heapPos[e.node] = pos;
+}
+
+void Pathfinder::push(int node, float f) {
+    int pos = static_cast<int>(m_heapSize++);
+    m_heap[pos] = { f, node };
+    siftUp(pos);
+}
+
+int Pathfinder::pop() {
+    int node = m_heap[0].node;
+    m_heapPos[node] = -1;
+    if (--m_heapSize > 0) {
+        m_heap[0] = m_heap[m_heapSize];
+        siftDown(0);
+    }
+    return node;
+}
+
+void Pathfinder::relax(int node, int parent, float g) {
+    if (m_closed[node] == m_generation) return;
+    int x = node % m_width, y = node / m_width;
+    if (m_seen[node] != m_generation) {
+        m_seen[node] = m_generation;
+        m_g[node] = g;
+        m_parent[node] = parent;
+        m_heapPos[node] = -1;
+        push(node, g + heuristic(x, y));
+    }
+    else if (g < m_g[node]) {
+        m_g[node] = g;
+        m_parent[node] = parent;
+        int pos = m_heapPos[node];
+        m_heap[pos].f = g + heuristic(x, y);
+        siftUp(pos);
+    }
+}
+
+void Pathfinder::expandAStar(int node) {
+    const TileGrid& grid = *m_grid;
+    int x = node % m_width, y = node / m_width;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            if (dx == 0 and dy == 0) continue;
+            int nx = x + dx, ny = y + dy;
+            if (grid.blocked(nx, ny)) continue;
+            // diagonal steps may not cut wall corners
+            if (dx != 0 and dy != 0 and (grid.blocked(x + dx, y) or grid.blocked(x, y + dy))) continue;
+            relax(index(nx, ny), node, m_g[node] + (dx != 0 and dy != 0 ? Sqrt2 : 1.f));
+        }
+    }
+}
+
+int Pathfinder::jumpStraight(int x, int y, int dx, int dy) const {
+    const TileGrid& grid = *m_grid;
+    for (;;) {
+        x += dx;
+        y += dy;
+        if (grid.blocked(x, y)) return -1;
+        if (x == m_goalX and y == m_goalY) return index(x, y);
+        // forced neighbours: a side opens up right after a wall that blocked it
+        if (dx != 0) {
+            if ((grid.walkable(x, y - 1) and grid.blocked(x - dx, y - 1)) or
+                (grid.walkable(x, y + 1) and grid.blocked(x - dx, y + 1))) return index(x, y);
+        }
+        else {
+            if ((grid.walkable(x - 1, y) and grid.blocked(x - 1, y - dy)) or
+                (grid.walkable(x + 1, y) and grid.blocked(x + 1, y - dy))) return index(x, y);
+        }
+    }
+}
+
+int Pathfinder::jump(int x, int y, int dx, int dy) const {
+    if (dx == 0 or dy == 0) return jumpStraight(x, y, dx, dy);
+
+    const TileGrid& grid = *m_grid;
+    for (;;) {
+        if (grid.blocked(x + dx, y) or grid.blocked(x, y + dy)) return -1;
+        x += dx;
+        y += dy;
+        if (grid.blocked(x, y)) return -1;
+        if (x == m_goalX and y == m_goalY) return index(x, y);
+        if (jumpStraight(x, y, dx, 0) >= 0 or jumpStraight(x, y, 0, dy) >= 0) return index(x, y);
+    }
+}
+
+void Pathfinder::expandJumpPoint(int node) {
+    const TileGrid& grid = *m_grid;
+    int x = node % m_width, y = node / m_width;
+
+    // pruned directions, at most 8
+    int dirs[8][2];
+    int count = 0;
+    auto add = [&](int dx, int dy) { dirs[count][0] = dx; dirs[count][1] = dy; ++count; };
+
+    int parent = m_parent[node];
+    if (parent < 0) {
+        for (int dy = -1; dy <= 1; ++dy)
+            for (int dx = -1; dx <= 1; ++dx)
+                if (dx != 0 or dy != 0) add(dx, dy);
+    }
+    else {
+        int dx = sign(x - parent % m_width);
+        int dy = sign(y - parent / m_width);
+        if (dx != 0 and dy != 0) {
+            add(0, dy);
+            add(dx, 0);
+            add(dx, dy);
+        }
+        else if (dx != 0) {
+            add(dx, 0);
+            add(dx, 1);
+            add(dx, -1);
+            add(0, 1);
+            add(0, -1);
+        }
+        else {
+            add(0, dy);
+            add(1, dy);
+            add(-1, dy);
+            add(1, 0);
+            add(-1, 0);
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        int dx = dirs[i][0], dy = dirs[i][1];
+        if (grid.blocked(x + dx, y + dy)) continue;
+        if (dx != 0 and dy != 0 and (grid.blocked(x + dx, y) or grid.blocked(x, y + dy))) continue;
+        int jp = jump(x, y, dx, dy);
+        if (jp < 0) continue;
+        int jx = jp % m_width, jy = jp / m_width;
+        relax(jp, node, m_g[node] + octile(jx - x, jy - y));
+    }
+}
+
+bool Pathfinder::findPath(const sf::Vector2i& start, const sf::Vector2i& goal, std::vector<sf::Vector2i>& path, Mode mode) {
+    path.clear();
+    m_expanded = 0;
+    if (m_grid->blocked(start.x, start.y) or m_grid->blocked(goal.x, goal.y)) return false;
+
+    // new generation invalidates all node state of the previous query
+    if (++m_generation == 0) {
+        std::fill(m_seen.begin(), m_seen.end(), 0);
+        std::fill(m_closed.begin(), m_closed.end(), 0);
+        m_generation = 1;
+    }
+    m_heapSize = 0;
+    m_goalX = goal.x;
+    m_goalY = goal.y;
+
+    const int startNode = index(start.x, start.y);
+    const int goalNode = index(goal.x, goal.y);
+    relax(startNode, -1, 0.f);
+
+    bool found = false;
+    while (m_heapSize > 0) {
+        int node = pop();
+        m_closed[node] = m_generation;
+        ++m_expanded;
+        if (node == goalNode) {
+            found = true;
+            break;
+        }
+        if (mode == Mode::JumpPoint) expandJumpPoint(node);
+        else expandAStar(node);
+    }
+    if (not found) return false;
+
+    // walk back over the parents, filling in the tiles between jump points
+    for (int node = goalNode; node >= 0; node = m_parent[node]) {
+        sf::Vector2i tile{ node % m_width, node / m_width };
+        int parent = m_parent[node];
+        path.push_back(tile);
+        if (parent < 0) break;
+        sf::Vector2i to{ parent % m_width, parent / m_width };
+        sf::Vector2i step{ sign(to.x - tile.x), sign(to.y - tile.y) };
+        for (sf::Vector2i t = tile + step; t != to; t += step) path.push_back(t);
+    }
+    std::reverse(path.begin(), path.end());
+    return true;
+}
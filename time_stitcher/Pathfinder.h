@@ -0,0 +1,66 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+#include "TileGrid.h"
+
+// 8-connected grid pathfinder (no corner cutting) over a TileGrid.
+// All per-node state is allocated once for the grid size. Nodes carry a generation stamp,
+// so a query never clears anything: bumping the generation invalidates the previous query.
+// The open list is an indexed binary heap (decrease-key instead of duplicate entries).
+class Pathfinder {
+public:
+    enum class Mode {
+        AStar,
+        JumpPoint  // Jump Point Search, same paths as A* on uniform cost grids with far fewer expansions
+    };
+
+    explicit Pathfinder(const TileGrid& grid);
+
+    // the grid must keep its size; call after the grid was replaced by one of another size
+    void rebind(const TileGrid& grid);
+
+    // fills `path` with every tile from start to goal (both included); false if unreachable
+    bool findPath(const sf::Vector2i& start, const sf::Vector2i& goal, std::vector<sf::Vector2i>& path, Mode mode = Mode::JumpPoint);
+
+    std::size_t lastExpanded() const { return m_expanded; }
+
+private:
+    int index(int x, int y) const { return y * m_width + x; }
+    float heuristic(int x, int y) const;
+
+    // open list
+    void push(int node, float f);
+    int pop();
+    void siftUp(int pos);
+    void siftDown(int pos);
+
+    // relax `node` reached from `parent` with cost g
+    void relax(int node, int parent, float g);
+
+    void expandAStar(int node);
+    void expandJumpPoint(int node);
+    int jump(int x, int y, int dx, int dy) const;
+    int jumpStraight(int x, int y, int dx, int dy) const;
+
+    const TileGrid* m_grid;
+    int m_width = 0;
+    int m_height = 0;
+    int m_goalX = 0;
+    int m_goalY = 0;
+
+    std::uint32_t m_generation = 0;
+    std::vector<std::uint32_t> m_seen;     // == generation: g/parent valid for this query
+    std::vector<std::uint32_t> m_closed;   // == generation: node expanded
+    std::vector<float> m_g;
+    std::vector<std::int32_t> m_parent;
+    std::vector<std::int32_t> m_heapPos;
+
+    struct HeapEntry {
+        float f;
+        std::int32_t node;
+    };
+    std::vector<HeapEntry> m_heap; // capacity = node count, never reallocates
+    std::size_t m_heapSize = 0;
+    std::size_t m_expanded = 0;
+};
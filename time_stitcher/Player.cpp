@@ -1,5 +1,6 @@
 #include "Player.h"
 #include "Obstacle.h"
+#include "MemoryTracker.h"
 #include <iostream>
 #include <cmath>
 #include <algorithm>
@@ -37,12 +38,18 @@ Player::Player(const std::string& texturePath, const Vector2f& startPos, float s
     // m_sprite.setOrigin({ 0,0 });
     m_sprite->setPosition(startPos);
 
+    // clip 0: the base texture, used by every direction until something else is loaded
+    m_animation.addClip(m_animation.addFrame(m_texture), 1, 0.10f);
+    buildMasks();
+
     m_loaded = true;
 }
 
 bool Player::setDirectionalTextures(const std::map<Direction, std::string>& paths) {
-    // Try to load each provided texture into m_textures. If any load fails we remove that entry and continue.
+    // Each loaded texture becomes a one frame clip. Failed loads are skipped.
+    // Directions that already have folder frames keep them (frames win over single textures).
     bool anyLoaded = false;
+    bool idleLoaded = false;
     for (const auto& [dir, path] : paths) {
         auto tex = std::make_unique<Texture>();
         if (not tex->loadFromFile(path)) {
@@ -50,15 +57,17 @@ bool Player::setDirectionalTextures(const std::map<Direction, std::string>& path
             continue;
         }
         tex->setSmooth(true);
-        m_textures[dir] = std::move(tex);
         anyLoaded = true;
-    }
+        if (m_hasFrames[toIndex(dir)]) continue;
 
-    // If directional textures have been provided and the player already has a sprite, update it to a matching texture (Idle -> keep default)
-    if (anyLoaded and m_sprite) {
-        // if there's a texture for Idle, apply it; otherwise keep the current m_texture
-        if (m_textures.count(Direction::Idle)) applyTextureForDirection(Direction::Idle);
+        const Texture& owned = m_animation.own(std::move(tex));
+        m_clips[toIndex(dir)] = m_animation.addClip(m_animation.addFrame(owned), 1, 0.10f);
+        if (dir == Direction::Idle) idleLoaded = true;
     }
+
+    buildMasks();
+    // if there's a texture for Idle, apply it; otherwise keep the current one
+    if (idleLoaded and m_sprite and m_direction == Direction::Idle) applyTextureForDirection(Direction::Idle);
     return anyLoaded;
 }
 
@@ -111,8 +120,8 @@ bool Player::loadDirectionalSpritesFromFolder(const std::string& rootPath, float
         if (files.empty()) continue;
         std::sort(files.begin(), files.end());
 
-        auto& vec = m_frames[dir];
-        vec.clear();
+        // frames of one direction are appended back to back and become one clip
+        const auto first = static_cast<std::uint32_t>(m_animation.frameCount());
         for (auto& p : files) {
             auto tex = std::make_unique<Texture>();
             if (not tex->loadFromFile(p.string())) {
@@ -120,21 +129,18 @@ bool Player::loadDirectionalSpritesFromFolder(const std::string& rootPath, float
                 continue;
             }
             tex->setSmooth(true);
-            vec.push_back(std::move(tex));
-        }
-        if (not vec.empty()) {
-            anyLoaded = true;
-        }
-        else {
-            // remove empty entry
-            m_frames.erase(dir);
+            m_animation.addFrame(m_animation.own(std::move(tex)));
         }
+        const auto count = static_cast<std::uint32_t>(m_animation.frameCount()) - first;
+        if (count == 0) continue;
+
+        m_clips[toIndex(dir)] = m_animation.addClip(first, count, frameTime);
+        m_hasFrames[toIndex(dir)] = true;
+        anyLoaded = true;
     }
 
+    buildMasks();
     if (anyLoaded) {
-        m_frameTime = frameTime;
-        m_animTimer = 0.f;
-        m_frameIndex = 0;
         // apply initial texture for current direction (or idle)
         if (m_sprite) {
             applyTextureForDirection(m_direction);
@@ -150,12 +156,49 @@ Vector2f Player::getPosition() const {
 }
 
 FloatRect Player::getBounds() const {
+    // the frames have transparent borders, the sprite box would collide before the player does
+    if (const CollisionMask* frameMask = mask()) {
+        const IntRect& solid = frameMask->opaqueBounds();
+        return FloatRect(Vector2f(maskTopLeft() + solid.position), Vector2f(solid.size));
+    }
     if (m_sprite) return m_sprite->getGlobalBounds();
     // fallback: empty rect at current position
     Vector2f p = getPosition();
     return FloatRect({ p.x, p.y }, { 0.f, 0.f });
 }
 
+const CollisionMask* Player::mask() const {
+    if (not m_sprite or m_anim.frame >= m_masks.size() or m_masks[m_anim.frame].empty()) return nullptr;
+    return &m_masks[m_anim.frame];
+}
+
+Vector2i Player::maskTopLeft() const {
+    if (not m_sprite) return { 0, 0 };
+    Vector2f topLeft = m_sprite->getPosition() - m_sprite->getOrigin().componentWiseMul(m_sprite->getScale());
+    return { static_cast<int>(std::lround(topLeft.x)), static_cast<int>(std::lround(topLeft.y)) };
+}
+
+void Player::buildMasks() {
+    if (not m_sprite) return;
+    memory::Scope tag(memory::Tag::Assets);
+    const float scale = m_sprite->getScale().x;
+    for (std::size_t i = m_masks.size(); i < m_animation.frameCount(); ++i) {
+        const AnimationFrame& frame = m_animation.frame(static_cast<std::uint32_t>(i));
+        m_masks.push_back(CollisionMask::fromImage(frame.texture->copyToImage(), frame.rect, scale));
+    }
+}
+
+std::size_t Player::textureBytes() const {
+    return memory::textureBytes(m_texture) + m_animation.textureBytes();
+}
+
+std::uint32_t Player::clipFor(const Vector2f& velocity) const {
+    // small sideways components (steering around tile centres) don't count as diagonal
+    const float deadZone = 0.4f * std::max(std::abs(velocity.x), std::abs(velocity.y));
+    Vector2f raw(std::abs(velocity.x) > deadZone ? velocity.x : 0.f, std::abs(velocity.y) > deadZone ? velocity.y : 0.f);
+    return m_clips[toIndex(chooseDirectionFromRaw(raw))];
+}
+
 bool Player::isLoaded() const {
     return m_loaded;
 }
@@ -182,46 +225,38 @@ Player::Direction Player::chooseDirectionFromRaw(const Vector2f& rawDir) const {
 }
 
 void Player::applyTextureForDirection(Direction dir) {
-    // Prefer animated frames if available
     if (not m_sprite) return;
+    animation::play(m_animation, m_anim, m_clips[toIndex(dir)]);
+    // the frame carries its own rect and centered origin, texture sizes may differ between frames
+    animation::apply(m_animation.frame(m_anim.frame), *m_sprite);
+}
 
-    auto fit = m_frames.find(dir);
-    if (fit != m_frames.end() and not fit->second.empty()) {
-        // clamp index
-        if (m_frameIndex >= fit->second.size()) m_frameIndex = 0;
-        m_sprite->setTexture(*fit->second[m_frameIndex]);
-    }
-    else {
-        // fallback to single texture per direction (legacy)
-        auto it = m_textures.find(dir);
-        if (it != m_textures.end() and it->second) {
-            m_sprite->setTexture(*it->second);
-        }
-        else {
-            // last fallback: original m_texture
-            m_sprite->setTexture(m_texture);
-        }
+void Player::restoreAnimation(Direction dir, const AnimationState& state) {
+    if (toIndex(dir) >= DirectionCount) return;
+    m_direction = dir;
+    applyTextureForDirection(dir);
+    // only take the saved frame if it still belongs to this clip (the sprites may have changed)
+    const AnimationClip& clip = m_animation.clip(m_anim.clip);
+    if (state.clip == m_anim.clip and state.frame >= clip.first and state.frame < clip.first + clip.count) {
+        m_anim = state;
+        if (m_sprite) animation::apply(m_animation.frame(m_anim.frame), *m_sprite);
     }
-
-    // Re-center origin because texture size may differ between directions/frames
-    FloatRect bounds = m_sprite->getLocalBounds();
-    m_sprite->setOrigin({ bounds.size.x * 0.5f, bounds.size.y * 0.5f });
 }
 
-void Player::update(float dt, const Vector2u& windowSize) {
+void Player::update(float dt, const FloatRect& area, const InputState& input) {
     if (not m_loaded) return;
 
     Vector2f rawDir(0.f, 0.f);
-    if (Keyboard::isKeyPressed(Keyboard::Key::W)) rawDir.y -= 1.f;
-    if (Keyboard::isKeyPressed(Keyboard::Key::S)) rawDir.y += 1.f;
-    if (Keyboard::isKeyPressed(Keyboard::Key::A)) rawDir.x -= 1.f;
-    if (Keyboard::isKeyPressed(Keyboard::Key::D)) rawDir.x += 1.f;
+    if (input.down(Keyboard::Key::W)) rawDir.y -= 1.f;
+    if (input.down(Keyboard::Key::S)) rawDir.y += 1.f;
+    if (input.down(Keyboard::Key::A)) rawDir.x -= 1.f;
+    if (input.down(Keyboard::Key::D)) rawDir.x += 1.f;
 
     Vector2f dir = rawDir;
     bool moving = (dir.x != 0.f or dir.y != 0.f);
 
     if (moving) {
-        float len = std::hypot(dir.x, dir.y);
+        float len = std::sqrt(dir.x * dir.x + dir.y * dir.y); // exactly rounded, unlike hypot
         if (len != 0.f) {
             dir.x /= len;
             dir.y /= len;
@@ -229,12 +264,12 @@ void Player::update(float dt, const Vector2u& windowSize) {
         Vector2f pos = m_sprite->getPosition();
         pos += dir * m_speed * dt;
 
-        // clamp so sprite stays fully inside the window
+        // clamp so sprite stays fully inside the area
         FloatRect bounds = m_sprite->getLocalBounds();
         float halfW = bounds.size.x * 0.5f;
         float halfH = bounds.size.y * 0.5f;
-        pos.x = std::clamp(pos.x, halfW, static_cast<float>(windowSize.x) - halfW);
-        pos.y = std::clamp(pos.y, halfH, static_cast<float>(windowSize.y) - halfH);
+        pos.x = std::clamp(pos.x, area.position.x + halfW, area.position.x + area.size.x - halfW);
+        pos.y = std::clamp(pos.y, area.position.y + halfH, area.position.y + area.size.y - halfH);
         // check if hits an obstacle 
 
         m_sprite->setPosition(pos);
@@ -244,34 +279,15 @@ void Player::update(float dt, const Vector2u& windowSize) {
     Direction newDir = chooseDirectionFromRaw(rawDir);
     if (newDir != m_direction) {
         m_direction = newDir;
-        m_frameIndex = 0;     // restart animation on direction change
-        m_animTimer = 0.f;
-        applyTextureForDirection(m_direction);
+        applyTextureForDirection(m_direction); // restart animation on direction change
     }
 
-    // advance animation frames if we have frames for this direction
+    // advance animation frames; the sprite is only touched when the frame actually changes
     bool shouldAnimate = moving or m_animateIdle;
-    auto fit = m_frames.find(m_direction);
-    if (fit != m_frames.end() and not fit->second.empty() and shouldAnimate) {
-        m_animTimer += dt;
-        if (m_animTimer >= m_frameTime) {
-            m_animTimer -= m_frameTime;
-            m_frameIndex = (m_frameIndex + 1) % fit->second.size();
-            // update sprite to new frame
-            m_sprite->setTexture(*fit->second[m_frameIndex]);
-            // re-center origin
-            FloatRect bounds = m_sprite->getLocalBounds();
-            m_sprite->setOrigin({ bounds.size.x * 0.5f, bounds.size.y * 0.5f });
-        }
-    }
-    else {
-        // If no frames for this direction, but we have a single texture, ensure it's applied
-        if (m_textures.count(m_direction) and m_sprite) {
-            m_sprite->setTexture(*m_textures[m_direction]);
-        }
-    }
+    if (shouldAnimate and animation::step(m_animation, m_anim, dt))
+        animation::apply(m_animation.frame(m_anim.frame), *m_sprite);
 }
 
-void Player::draw(RenderWindow& window) {
-    if (m_loaded and m_sprite) window.draw(*m_sprite);
+void Player::draw(RenderTarget& target) {
+    if (m_loaded and m_sprite) target.draw(*m_sprite);
 }
\ No newline at end of file
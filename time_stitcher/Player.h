@@ -2,9 +2,13 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <optional>
+#include <array>
 #include <map>
 #include <memory>
 #include <vector>
+#include "Animation.h"
+#include "InputState.h"
+#include "CollisionMask.h"
 
 using namespace sf;
 
@@ -19,10 +23,15 @@ public:
     void setPosition(const Vector2f& pos);
 
     Vector2f getPosition() const;
+    // box of the solid pixels of the current frame (the sprite box if there is no mask)
     FloatRect getBounds() const;
+    // alpha mask of the current frame in world pixels, placed at maskTopLeft(); nullptr if none
+    const CollisionMask* mask() const;
+    Vector2i maskTopLeft() const;
 
-    void update(float dt, const Vector2u& windowSize);
-    void draw(RenderWindow& window);
+    // area: world rectangle the player is kept inside; input: key state of this tick
+    void update(float dt, const FloatRect& area, const InputState& input);
+    void draw(RenderTarget& target);
 
     // Directional sprites API
     enum class Direction {
@@ -36,6 +45,7 @@ public:
         DownLeft,
         DownRight
     };
+    static constexpr std::size_t DirectionCount = 9;
 
     // Legacy: register single textures per direction (keeps compatibility)
     bool setDirectionalTextures(const std::map<Direction, std::string>& paths);
@@ -50,7 +60,20 @@ public:
     // frameTime = seconds per frame
     bool loadDirectionalSpritesFromFolder(const std::string& rootPath, float frameTime = 0.10f);
 
-    void setAnimationFrameTime(float frameTime) { m_frameTime = frameTime; }
+    // frames and clips, e.g. to pack them for echoes of the player (AnimationSet::packed)
+    const AnimationSet& animations() const { return m_animation; }
+    // clip the player would play when moving along `velocity`
+    std::uint32_t clipFor(const Vector2f& velocity) const;
+
+    // for snapshots
+    Direction direction() const { return m_direction; }
+    const AnimationState& animationState() const { return m_anim; }
+    void restoreAnimation(Direction dir, const AnimationState& state);
+
+    // estimated video memory of all textures the player owns
+    std::size_t textureBytes() const;
+
+    void setAnimationFrameTime(float frameTime) { m_animation.setFrameTime(frameTime); } // all clips
     void setAnimateIdle(bool animate) { m_animateIdle = animate; }
 
 private:
@@ -59,20 +82,23 @@ private:
     float m_speed;
     bool m_loaded;
 
-    // Legacy single textures per direction
-    std::map<Direction, std::unique_ptr<Texture>> m_textures;
+    // all frames (base texture, legacy single textures, folder animations) in one flat set,
+    // plus the clip of each direction; directions without own frames use clip 0 (base texture)
+    AnimationSet m_animation;
+    std::array<std::uint32_t, DirectionCount> m_clips{};
+    std::array<bool, DirectionCount> m_hasFrames{}; // clip comes from a sprite folder (wins over legacy textures)
 
-    // Multiple frames per direction (owned)
-    std::map<Direction, std::vector<std::unique_ptr<Texture>>> m_frames;
+    // per frame of m_animation, built when frames are loaded
+    std::vector<CollisionMask> m_masks;
 
     // animation state
     Direction m_direction = Direction::Idle;
-    float m_frameTime = 0.10f; // seconds per frame
-    float m_animTimer = 0.f;
-    size_t m_frameIndex = 0;
+    AnimationState m_anim;
     bool m_animateIdle = false;
 
     // helper
+    static constexpr std::size_t toIndex(Direction dir) { return static_cast<std::size_t>(dir); }
     Direction chooseDirectionFromRaw(const Vector2f& rawDir) const;
-    void applyTextureForDirection(Direction dir); // sets sprite texture + origin
+    void applyTextureForDirection(Direction dir); // restarts the direction's clip on the sprite
+    void buildMasks(); // for the frames added since the last call
 };
\ No newline at end of file
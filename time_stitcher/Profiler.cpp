@@ -0,0 +1,47 @@
+#include "Profiler.h"
+
+const char* Profiler::phaseName(Phase phase) {
+    switch (phase) {
+    case Phase::Sleep:      return "sleep";
+    case Phase::Spin:       return "spin";
+    case Phase::Events:     return "events";
+    case Phase::Simulation: return "simulation";
+    case Phase::Render:     return "render";
+    case Phase::Present:    return "present";
+    default:                return "?";
+    }
+}
+
+void Profiler::addLatency(sf::Time time) {
+    const std::int64_t us = time.asMicroseconds();
+    m_latencyTotal += us;
+    if (us > m_latencyMax) m_latencyMax = us;
+    ++m_latencySamples;
+}
+
+void Profiler::reset() {
+    m_clock.restart();
+    m_totals.fill(0);
+    m_frames = 0;
+    m_latencyTotal = 0;
+    m_latencyMax = 0;
+    m_latencySamples = 0;
+}
+
+sf::Time Profiler::average(Phase phase) const {
+    if (m_frames == 0) return sf::Time::Zero;
+    return sf::microseconds(m_totals[static_cast<std::size_t>(phase)] / m_frames);
+}
+
+float Profiler::busy() const {
+    const std::int64_t wall = m_clock.getElapsedTime().asMicroseconds();
+    if (wall <= 0) return 0.f;
+    const std::int64_t idle = m_totals[static_cast<std::size_t>(Phase::Sleep)]
+        + m_totals[static_cast<std::size_t>(Phase::Present)];
+    return static_cast<float>(wall - idle) / static_cast<float>(wall);
+}
+
+sf::Time Profiler::averageLatency() const {
+    if (m_latencySamples == 0) return sf::Time::Zero;
+    return sf::microseconds(m_latencyTotal / m_latencySamples);
+}
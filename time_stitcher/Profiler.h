@@ -0,0 +1,59 @@
+#pragma once
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <array>
+#include <cstdint>
+
+// Where the main thread spends a frame, averaged over the frames since the last reset()
+// (the HUD resets it every time it updates), and how long input takes to reach the screen.
+class Profiler {
+public:
+    enum class Phase : std::uint8_t {
+        Sleep,      // idle in the frame pacer
+        Spin,       // busy waiting in the frame pacer
+        Events,
+        Simulation,
+        Render,
+        Present,    // display(), blocks in the driver with vsync
+        Count
+    };
+    static const char* phaseName(Phase phase);
+
+    // adds the time it is alive to `phase`
+    class Scope {
+    public:
+        Scope(Profiler& profiler, Phase phase) : m_profiler(profiler), m_phase(phase) {}
+        ~Scope() { m_profiler.add(m_phase, m_clock.getElapsedTime()); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Profiler& m_profiler;
+        Phase m_phase;
+        sf::Clock m_clock;
+    };
+
+    void add(Phase phase, sf::Time time) { m_totals[static_cast<std::size_t>(phase)] += time.asMicroseconds(); }
+    // from the input event to the present of the first frame that shows it
+    void addLatency(sf::Time time);
+    void endFrame() { ++m_frames; }
+    void reset();
+
+    unsigned frames() const { return m_frames; }
+    sf::Time elapsed() const { return m_clock.getElapsedTime(); }
+    sf::Time average(Phase phase) const;
+    // share of the wall time the main thread was working: not sleeping or blocked in display()
+    float busy() const;
+    sf::Time averageLatency() const;
+    sf::Time maxLatency() const { return sf::microseconds(m_latencyMax); }
+    unsigned latencySamples() const { return m_latencySamples; }
+
+private:
+    sf::Clock m_clock;
+    std::array<std::int64_t, static_cast<std::size_t>(Phase::Count)> m_totals{};
+    unsigned m_frames = 0;
+    std::int64_t m_latencyTotal = 0;
+    std::int64_t m_latencyMax = 0;
+    unsigned m_latencySamples = 0;
+};
@@ -0,0 +1,119 @@
+#include "Raycaster.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    constexpr float Infinity = std::numeric_limits<float>::infinity();
+
+    // exact slab test; fraction of the entry point, or false
+    bool intersect(const sf::FloatRect& box, sf::Vector2f from, sf::Vector2f d, float maxFraction, float& fraction) {
+        float t0 = 0.f, t1 = maxFraction;
+        const float o[2] = { from.x, from.y }, v[2] = { d.x, d.y };
+        const float lo[2] = { box.position.x, box.position.y };
+        const float hi[2] = { box.position.x + box.size.x, box.position.y + box.size.y };
+        for (int axis = 0; axis < 2; ++axis) {
+            if (v[axis] == 0.f) {
+                if (o[axis] < lo[axis] or o[axis] > hi[axis]) return false;
+                continue;
+            }
+            float a = (lo[axis] - o[axis]) / v[axis], b = (hi[axis] - o[axis]) / v[axis];
+            if (a > b) std::swap(a, b);
+            t0 = std::max(t0, a);
+            t1 = std::min(t1, b);
+            if (t0 > t1) return false;
+        }
+        fraction = t0;
+        return true;
+    }
+
+    // traversal state of one ray, in tiles
+    struct Walk {
+        int x, y, stepX, stepY;
+        float tMaxX, tMaxY, tDeltaX, tDeltaY;
+    };
+
+    Walk start(const Ray& ray, float tileSize) {
+        const sf::Vector2f p = ray.from / tileSize;
+        const sf::Vector2f d = (ray.to - ray.from) / tileSize;
+        Walk w;
+        w.x = static_cast<int>(std::floor(p.x));
+        w.y = static_cast<int>(std::floor(p.y));
+        w.stepX = d.x > 0.f ? 1 : -1;
+        w.stepY = d.y > 0.f ? 1 : -1;
+        w.tDeltaX = d.x != 0.f ? 1.f / std::abs(d.x) : Infinity;
+        w.tDeltaY = d.y != 0.f ? 1.f / std::abs(d.y) : Infinity;
+        w.tMaxX = d.x == 0.f ? Infinity : (d.x > 0.f ? (w.x + 1 - p.x) : (p.x - w.x)) * w.tDeltaX;
+        w.tMaxY = d.y == 0.f ? Infinity : (d.y > 0.f ? (w.y + 1 - p.y) : (p.y - w.y)) * w.tDeltaY;
+        return w;
+    }
+
+    void hitWall(const Ray& ray, RayHit& hit, float t, int x, int y) {
+        hit.hit = true;
+        hit.fraction = t;
+        hit.point = ray.from + (ray.to - ray.from) * t;
+        hit.tile = { x, y };
+    }
+}
+
+RayHit Raycaster::castWalls(const Ray& ray) const {
+    RayHit hit;
+    hit.point = ray.to;
+    Walk w = start(ray, m_tileSize);
+    if (m_grid->blocked(w.x, w.y)) {
+        hitWall(ray, hit, 0.f, w.x, w.y);
+        return hit;
+    }
+    for (;;) {
+        float t;
+        if (w.tMaxX < w.tMaxY) {
+            t = w.tMaxX;
+            w.x += w.stepX;
+            w.tMaxX += w.tDeltaX;
+        }
+        else {
+            t = w.tMaxY;
+            w.y += w.stepY;
+            w.tMaxY += w.tDeltaY;
+        }
+        if (t > 1.f) return hit;
+        if (m_grid->blocked(w.x, w.y)) {
+            hitWall(ray, hit, t, w.x, w.y);
+            return hit;
+        }
+    }
+}
+
+void Raycaster::castObstacles(const Ray& ray, RayHit& hit) const {
+    if (not m_tree or not m_obstacleBox or hit.fraction <= 0.f) return;
+    const sf::Vector2f d = ray.to - ray.from;
+    // only what lies before the wall hit; the tree measures fractions along that shorter segment
+    const float length = hit.fraction;
+    m_tree->raycast(ray.from, ray.from + d * length, [&](int proxy, float maxFraction) {
+        sf::FloatRect box;
+        float fraction;
+        const std::uint32_t data = m_tree->userData(proxy);
+        if (not m_obstacleBox(data, box) or not intersect(box, ray.from, d, maxFraction * length, fraction))
+            return maxFraction;
+        hit.hit = true;
+        hit.fraction = fraction;
+        hit.point = ray.from + d * fraction;
+        hit.tile = { -1, -1 };
+        hit.obstacle = data;
+        return fraction / length;
+    });
+}
+
+RayHit Raycaster::cast(const Ray& ray) const {
+    RayHit hit = castWalls(ray);
+    castObstacles(ray, hit);
+    return hit;
+}
+
+void Raycaster::cast(std::span<const Ray> rays, std::span<RayHit> hits) const {
+    const std::size_t n = std::min(rays.size(), hits.size());
+    for (std::size_t i = 0; i < n; ++i) hits[i] = castWalls(rays[i]);
+    // obstacles in a second pass, the tree stays in cache
+    if (m_tree and m_obstacleBox)
+        for (std::size_t i = 0; i < n; ++i) castObstacles(rays[i], hits[i]);
+}
@@ -0,0 +1,124 @@
+#include "ResolutionManager.h"
+#include "MemoryTracker.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    // a step down is big enough to matter, a step up small enough not to overshoot again
+    constexpr float StepDown = 0.85f;
+    constexpr float StepUp = 1.05f;
+    constexpr float Headroom = 0.7f; // scale up below this share of the budget
+    constexpr int Cooldown = 30;     // frames for the smoothed time to follow a change
+
+    // the world is drawn with alpha blending onto transparent black, which leaves
+    // premultiplied colors in the offscreen texture
+    const sf::BlendMode BlendPremultiplied(sf::BlendMode::Factor::One, sf::BlendMode::Factor::OneMinusSrcAlpha);
+}
+
+void ResolutionManager::setBackground(const sf::Texture* texture) {
+    m_background = texture;
+    m_cache.clear();
+}
+
+void ResolutionManager::resize(sf::Vector2u size) {
+    if (size.x == 0 or size.y == 0 or size == m_size) return;
+    m_size = size;
+    memory::Scope tag(memory::Tag::Rendering);
+    m_offscreen.reset();
+    m_scale = 1.f;
+    m_cooldown = Cooldown;
+}
+
+const sf::Texture* ResolutionManager::resampledBackground() {
+    if (not m_background or m_size.x == 0) return nullptr;
+    auto found = std::find_if(m_cache.begin(), m_cache.end(), [&](const Resampled& r) { return r.size == m_size; });
+    if (found != m_cache.end()) {
+        std::rotate(found, found + 1, m_cache.end());
+        return &m_cache.back().texture.getTexture();
+    }
+
+    memory::Scope tag(memory::Tag::Rendering);
+    sf::RenderTexture texture;
+    if (not texture.resize(m_size)) {
+        std::cerr << "Failed to resample the background to " << m_size.x << "x" << m_size.y << "\n";
+        return nullptr;
+    }
+    sf::Sprite sprite(*m_background);
+    auto source = m_background->getSize();
+    sprite.setScale({ static_cast<float>(m_size.x) / source.x, static_cast<float>(m_size.y) / source.y });
+    texture.clear();
+    texture.draw(sprite);
+    texture.display();
+
+    if (m_cache.size() == MaxCached) m_cache.erase(m_cache.begin());
+    m_cache.push_back({ m_size, std::move(texture) });
+    return &m_cache.back().texture.getTexture();
+}
+
+void ResolutionManager::drawBackground(sf::RenderTarget& target) {
+    const sf::Texture* texture = resampledBackground();
+    if (texture) target.draw(sf::Sprite(*texture));
+}
+
+std::size_t ResolutionManager::textureBytes() const {
+    std::size_t total = m_offscreen ? memory::textureBytes(m_offscreen->getTexture()) : 0;
+    for (const Resampled& r : m_cache)
+        total += memory::textureBytes(r.texture.getTexture());
+    return total;
+}
+
+void ResolutionManager::adapt(sf::Time frameTime, sf::Time budget) {
+    m_smoothed += (frameTime - m_smoothed) * 0.1f;
+    if (m_cooldown > 0) {
+        --m_cooldown;
+        return;
+    }
+    float next = m_scale;
+    if (m_smoothed > budget) next = std::max(m_scale * StepDown, m_minScale);
+    else if (m_smoothed < budget * Headroom) next = std::min(m_scale * StepUp, 1.f);
+    if (next == m_scale) return;
+    m_scale = next;
+    m_cooldown = Cooldown;
+}
+
+sf::RenderTarget& ResolutionManager::beginWorld(sf::RenderWindow& window, const sf::View& view) {
+    m_offscreenActive = false;
+    if (m_scale < 1.f) {
+        if (not m_offscreen) {
+            memory::Scope tag(memory::Tag::Rendering);
+            m_offscreen.emplace();
+            if (not m_offscreen->resize(m_size)) {
+                std::cerr << "Failed to create the offscreen target, rendering at full scale\n";
+                m_offscreen.reset();
+                m_scale = 1.f;
+            }
+            else {
+                m_offscreen->setSmooth(true);
+            }
+        }
+        if (m_offscreen) m_offscreenActive = true;
+    }
+    if (not m_offscreenActive) {
+        window.setView(view);
+        return window;
+    }
+
+    // the whole view into the top left part of the texture
+    sf::View scaled = view;
+    scaled.setViewport(sf::FloatRect({ 0.f, 0.f }, { m_scale, m_scale }));
+    m_offscreen->setView(scaled);
+    m_offscreen->clear(sf::Color::Transparent);
+    return *m_offscreen;
+}
+
+void ResolutionManager::endWorld(sf::RenderWindow& window) {
+    if (not m_offscreenActive) return;
+    m_offscreen->display();
+
+    sf::Vector2i used(static_cast<int>(std::lround(m_size.x * m_scale)), static_cast<int>(std::lround(m_size.y * m_scale)));
+    sf::Sprite sprite(m_offscreen->getTexture(), sf::IntRect({ 0, 0 }, used));
+    sprite.setScale({ static_cast<float>(m_size.x) / used.x, static_cast<float>(m_size.y) / used.y });
+    window.setView(screenView());
+    window.draw(sprite, sf::RenderStates(BlendPremultiplied));
+}
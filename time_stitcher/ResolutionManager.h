@@ -0,0 +1,64 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <optional>
+#include <vector>
+
+// Maps the window to the world and keeps per-resolution copies of what doesn't change.
+//  - The view always shows the same number of world units vertically, the width follows the
+//    aspect ratio of the window; pixelsPerUnit() converts.
+//  - The background is resampled once per window size (a few sizes are kept, so toggling
+//    between them is free) and then drawn 1:1 instead of filtering the full image every frame.
+//  - Dynamic render scale: when frames take longer than the budget the world is drawn into
+//    a smaller part of an offscreen texture and stretched over the window, so the resolution
+//    drops instead of the frame rate. It recovers once there is headroom again.
+class ResolutionManager {
+public:
+    // logicalHeight: world units visible vertically
+    explicit ResolutionManager(float logicalHeight) : m_logicalHeight(logicalHeight) {}
+
+    // the texture is only referenced; smooth with mipmaps gives the best downscale
+    void setBackground(const sf::Texture* texture);
+    // new client size of the window; an empty size (minimized) is ignored
+    void resize(sf::Vector2u size);
+
+    sf::Vector2u size() const { return m_size; }
+    float pixelsPerUnit() const { return m_size.y / m_logicalHeight; }
+    sf::Vector2f viewSize() const { return { m_size.x / pixelsPerUnit(), m_logicalHeight }; }
+    // one unit per pixel; the window's default view keeps the size it was created with
+    sf::View screenView() const { return sf::View(sf::FloatRect({ 0.f, 0.f }, sf::Vector2f(m_size))); }
+
+    // frameTime: from the start of a frame to its present, budget: what it may take
+    void adapt(sf::Time frameTime, sf::Time budget);
+    void setMinScale(float scale) { m_minScale = scale; }
+    float renderScale() const { return m_scale; }
+    // estimated video memory of the resampled backgrounds and the offscreen target
+    std::size_t textureBytes() const;
+
+    // resamples on the first draw at a new size
+    void drawBackground(sf::RenderTarget& target);
+    // target for the world, drawn with `view`: the window itself at full scale, the
+    // offscreen texture otherwise; endWorld() puts it on the window
+    sf::RenderTarget& beginWorld(sf::RenderWindow& window, const sf::View& view);
+    void endWorld(sf::RenderWindow& window);
+
+private:
+    struct Resampled {
+        sf::Vector2u size;
+        sf::RenderTexture texture;
+    };
+    static constexpr std::size_t MaxCached = 3;
+
+    const sf::Texture* resampledBackground();
+
+    float m_logicalHeight;
+    sf::Vector2u m_size;
+    const sf::Texture* m_background = nullptr;
+    std::vector<Resampled> m_cache; // most recently used last
+
+    std::optional<sf::RenderTexture> m_offscreen; // window sized, only the scaled part is used
+    float m_scale = 1.f;
+    float m_minScale = 0.5f;
+    sf::Time m_smoothed;
+    int m_cooldown = 0;             // frames until the scale may change again
+    bool m_offscreenActive = false;
+};
@@ -0,0 +1,50 @@
+#include "RunState.h"
+
+const char* RunState::stateName(State state) {
+    switch (state) {
+    case State::Active:     return "active";
+    case State::Background: return "background";
+    case State::Minimized:  return "minimized";
+    default:                return "?";
+    }
+}
+
+bool RunState::handle(const sf::Event& event) {
+    if (event.is<sf::Event::FocusGained>())
+        return set(State::Active);
+    if (event.is<sf::Event::FocusLost>())
+        return set(m_state == State::Minimized ? State::Minimized : State::Background);
+    if (const auto* resized = event.getIf<sf::Event::Resized>()) {
+        if (resized->size.x == 0 or resized->size.y == 0)
+            return set(State::Minimized);
+        m_redraw = true;
+        // restored without the focus coming back
+        if (m_state == State::Minimized) return set(State::Background);
+    }
+    return false;
+}
+
+bool RunState::poll(const sf::Vector2u& clientSize) {
+    // minimizing takes the focus first (FocusLost), so Active never needs the check
+    if (m_state == State::Active) return false;
+    const bool empty = clientSize.x == 0 or clientSize.y == 0;
+    if (empty) return set(State::Minimized);
+    // restored without the focus coming back
+    if (m_state == State::Minimized) return set(State::Background);
+    return false;
+}
+
+bool RunState::set(State state) {
+    if (state == m_state) return false;
+    m_state = state;
+    m_redraw = state == State::Background;
+    return true;
+}
+
+sf::Time RunState::wakeInterval() const {
+    switch (m_state) {
+    case State::Background: return sf::milliseconds(100);
+    case State::Minimized:  return sf::milliseconds(250);
+    default:                return sf::Time::Zero;
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <SFML/System/Time.hpp>
+#include <SFML/Window/Event.hpp>
+
+// What the game does while the player isn't looking.
+//   Active:     focused, simulates and renders at the frame pacer's rate
+//   Background: unfocused, wakes a few times a second to run the ticks that are due
+//               (ghosts and chasers keep real time) and doesn't render
+//   Minimized:  not visible, the simulation is suspended and events are polled rarely
+// SFML has no minimize or occlusion event, and on Win32 it drops the WM_SIZE of a minimize, so
+// no Resized arrives either. Outside Active the client area is polled instead: an empty one is
+// taken as minimized (a resize to an empty area counts too, where the platform sends one).
+class RunState {
+public:
+    enum class State {
+        Active,
+        Background,
+        Minimized,
+        Count
+    };
+    static const char* stateName(State state);
+
+    // FocusLost, FocusGained and Resized; other events are ignored. true if the state changed
+    bool handle(const sf::Event& event);
+    // current client area, once per frame after the events; true if the state changed
+    bool poll(const sf::Vector2u& clientSize);
+
+    State state() const { return m_state; }
+    bool simulates() const { return m_state != State::Minimized; }
+    // Background renders once after a resize, so the window isn't left with stale contents
+    bool renders() const { return m_state == State::Active or m_redraw; }
+    void rendered() { m_redraw = false; }
+    // sleep between frames outside Active (in Active the frame pacer decides)
+    sf::Time wakeInterval() const;
+
+private:
+    bool set(State state);
+
+    State m_state = State::Active;
+    bool m_redraw = false;
+};
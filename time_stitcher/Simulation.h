@@ -0,0 +1,8 @@
+#pragma once
+
+// Fixed simulation rate. Game::update always advances by TickTime, so the same inputs give
+// bit-identical state on every run (see StateHash.h); rendering runs at whatever rate it can.
+namespace sim {
+    constexpr int TicksPerSecond = 60;
+    constexpr float TickTime = 1.f / TicksPerSecond;
+}
@@ -0,0 +1,98 @@
+#include "Snapshot.h"
+#include <fstream>
+#include <iostream>
+
+namespace {
+    std::uint64_t alignUp(std::uint64_t offset) {
+        return (offset + snapshot::Alignment - 1) & ~static_cast<std::uint64_t>(snapshot::Alignment - 1);
+    }
+}
+
+bool SnapshotWriter::save(const std::string& path) const {
+    using namespace snapshot;
+    std::vector<SectionEntry> table;
+    table.reserve(m_sections.size());
+    std::uint64_t offset = alignUp(sizeof(Header) + m_sections.size() * sizeof(SectionEntry));
+    for (const Pending& section : m_sections) {
+        table.push_back({ static_cast<std::uint32_t>(section.id), static_cast<std::uint32_t>(section.recordSize), offset, section.count });
+        offset = alignUp(offset + section.recordSize * section.count);
+    }
+    Header header{ Magic, Version, static_cast<std::uint32_t>(table.size()), 0, offset };
+
+    std::ofstream out(path, std::ios::binary);
+    if (not out) {
+        std::cerr << "Failed to write " << path << '\n';
+        return false;
+    }
+    // sections are written straight from the game's arrays, no intermediate copy
+    const char zeros[Alignment] = {};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(SectionEntry)));
+    std::uint64_t written = sizeof(header) + table.size() * sizeof(SectionEntry);
+    for (std::size_t i = 0; i < m_sections.size(); ++i) {
+        out.write(zeros, static_cast<std::streamsize>(table[i].offset - written));
+        std::uint64_t bytes = m_sections[i].recordSize * m_sections[i].count;
+        out.write(static_cast<const char*>(m_sections[i].data), static_cast<std::streamsize>(bytes));
+        written = table[i].offset + bytes;
+    }
+    out.write(zeros, static_cast<std::streamsize>(offset - written));
+    if (not out) {
+        std::cerr << "Failed to write " << path << '\n';
+        return false;
+    }
+    return true;
+}
+
+bool Snapshot::load(const std::string& path) {
+    using namespace snapshot;
+    m_sections.assign(static_cast<std::size_t>(Section::Count), View{});
+    m_recordSizes.assign(static_cast<std::size_t>(Section::Count), 0);
+
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (not in) {
+        std::cerr << "Failed to load " << path << '\n';
+        return false;
+    }
+    const auto size = static_cast<std::uint64_t>(in.tellg());
+    if (size < sizeof(Header)) {
+        std::cerr << path << " is not a snapshot\n";
+        return false;
+    }
+    m_buffer.resize((size + 7) / 8);
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(size));
+    if (not in) {
+        std::cerr << "Failed to read " << path << '\n';
+        return false;
+    }
+
+    const auto* base = reinterpret_cast<const unsigned char*>(m_buffer.data());
+    const auto* header = reinterpret_cast<const Header*>(base);
+    if (header->magic != Magic or header->fileSize != size) {
+        std::cerr << path << " is not a snapshot\n";
+        return false;
+    }
+    if (header->version != Version) {
+        std::cerr << path << ": unsupported snapshot version " << header->version << '\n';
+        return false;
+    }
+    if (sizeof(Header) + std::uint64_t{ header->sectionCount } * sizeof(SectionEntry) > size) {
+        std::cerr << path << " is truncated\n";
+        return false;
+    }
+
+    // the only "parsing": offsets to pointers, after checking they stay inside the file
+    const auto* table = reinterpret_cast<const SectionEntry*>(base + sizeof(Header));
+    for (std::uint32_t i = 0; i < header->sectionCount; ++i) {
+        const SectionEntry& entry = table[i];
+        if (entry.id >= static_cast<std::uint32_t>(Section::Count)) continue; // newer section, ignored
+        if (entry.offset % Alignment != 0 or entry.offset > size
+            or (entry.recordSize > 0 and entry.count > (size - entry.offset) / entry.recordSize)) {
+            std::cerr << path << " has a broken section table\n";
+            return false;
+        }
+        m_sections[entry.id] = { base + entry.offset, static_cast<std::size_t>(entry.count) };
+        m_recordSizes[entry.id] = entry.recordSize;
+    }
+    return true;
+}
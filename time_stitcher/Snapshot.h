@@ -0,0 +1,150 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Versioned binary save format. A file is a header, a table of sections and the sections
+// themselves: plain arrays of trivially copyable records (mostly the SoA arrays of the game
+// as they are in memory), each starting at an aligned offset. Loading reads the file into
+// one buffer and turns the offsets into pointers; records are used in place, nothing is parsed.
+namespace snapshot {
+    constexpr std::uint32_t Magic = 0x4E535354; // "TSSN"
+    constexpr std::uint32_t Version = 1;
+    constexpr std::size_t Alignment = 8; // of every section offset; loads into an 8 byte aligned buffer
+
+    enum class Section : std::uint32_t {
+        World,
+        Obstacles,
+        Strings,          // '\0' separated, referenced by byte offset
+        Chasers,
+        GhostTracks,
+        GhostTrackBytes,
+        GhostPlayback,
+        GhostX,
+        GhostY,
+        GhostBlocked,
+        GhostTrackIndex,
+        Recording,
+        RecordingBytes,
+        Hashes,
+        Count
+    };
+
+    struct Header {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t sectionCount;
+        std::uint32_t reserved;
+        std::uint64_t fileSize;
+    };
+
+    struct SectionEntry {
+        std::uint32_t id;
+        std::uint32_t recordSize; // checked on load, catches layout changes without a version bump
+        std::uint64_t offset;
+        std::uint64_t count;
+    };
+
+    // records without a runtime counterpart that could be written as is
+
+    struct WorldRecord {
+        std::uint32_t mazeSeed;
+        std::int32_t mazeWidth, mazeHeight;
+        std::int32_t startX, startY, goalX, goalY;
+        std::uint32_t reserved;
+        std::uint64_t tick;
+        float playerX, playerY;
+        std::int32_t playerDirection;
+        std::uint32_t animClip, animFrame;
+        float animTimer;
+    };
+
+    struct ObstacleRecord {
+        float x, y;                 // constructor position
+        std::int32_t touchTicks;
+        std::int32_t texture;       // byte offset of the path in Strings, -1: untextured
+        std::uint8_t collidable, didTouch, reserved[2];
+    };
+
+    struct ChaserRecord {
+        float x, y, vx, vy, speed;
+    };
+
+    struct GhostTrackRecord {
+        std::int32_t startX, startY;
+        std::uint32_t ticks, reserved;
+        std::uint64_t byteOffset, byteCount; // in GhostTrackBytes
+    };
+
+    struct RecordingRecord {
+        std::int32_t startX, startY;
+        std::uint32_t ticks;
+        std::int32_t lastX, lastY;
+        float timer;
+        std::uint32_t recording, reserved;
+    };
+}
+
+class SnapshotWriter {
+public:
+    // the data is only referenced and must stay alive until save() returns
+    template <typename T>
+    void add(snapshot::Section id, const T* data, std::size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        m_sections.push_back({ id, sizeof(T), data, count });
+    }
+    template <typename T>
+    void add(snapshot::Section id, const std::vector<T>& values) { add(id, values.data(), values.size()); }
+    // for records built just for the snapshot: the writer keeps them alive
+    template <typename T>
+    void addOwned(snapshot::Section id, std::vector<T> values) {
+        auto owned = std::make_shared<std::vector<T>>(std::move(values));
+        add(id, owned->data(), owned->size());
+        m_owned.push_back(std::move(owned));
+    }
+
+    bool save(const std::string& path) const;
+
+private:
+    struct Pending {
+        snapshot::Section id;
+        std::size_t recordSize;
+        const void* data;
+        std::size_t count;
+    };
+    std::vector<Pending> m_sections;
+    std::vector<std::shared_ptr<void>> m_owned;
+};
+
+class Snapshot {
+public:
+    bool load(const std::string& path);
+
+    // records of a section in place, empty if the file doesn't have it or its layout differs
+    template <typename T>
+    std::span<const T> get(snapshot::Section id) const {
+        static_assert(std::is_trivially_copyable_v<T>);
+        auto i = static_cast<std::size_t>(id);
+        if (i >= m_sections.size() or m_recordSizes[i] != sizeof(T)) return {};
+        return { static_cast<const T*>(m_sections[i].data), m_sections[i].count };
+    }
+    // record of a single record section
+    template <typename T>
+    const T* one(snapshot::Section id) const {
+        auto records = get<T>(id);
+        return records.empty() ? nullptr : &records[0];
+    }
+
+private:
+    struct View {
+        const void* data = nullptr;
+        std::size_t count = 0;
+    };
+    std::vector<std::uint64_t> m_buffer; // 8 byte aligned
+    std::vector<View> m_sections;         // by Section id
+    std::vector<std::size_t> m_recordSizes;
+};
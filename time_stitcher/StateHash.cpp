@@ -0,0 +1,132 @@
+#include "StateHash.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    constexpr std::uint64_t Prime1 = 0x9E3779B185EBCA87ull;
+    constexpr std::uint64_t Prime2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr std::uint64_t Prime3 = 0x165667B19E3779F9ull;
+    constexpr std::uint64_t Prime4 = 0x85EBCA77C2B2AE63ull;
+    constexpr std::uint64_t Prime5 = 0x27D4EB2F165667C5ull;
+
+    std::uint64_t rotl(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+    // little endian, like every platform we build for
+    std::uint64_t read64(const unsigned char* p) { std::uint64_t v; std::memcpy(&v, p, 8); return v; }
+    std::uint32_t read32(const unsigned char* p) { std::uint32_t v; std::memcpy(&v, p, 4); return v; }
+
+    std::uint64_t round(std::uint64_t acc, std::uint64_t input) {
+        acc += input * Prime2;
+        acc = rotl(acc, 31);
+        return acc * Prime1;
+    }
+
+    std::uint64_t mergeRound(std::uint64_t acc, std::uint64_t value) {
+        acc ^= round(0, value);
+        return acc * Prime1 + Prime4;
+    }
+}
+
+StateHasher::StateHasher(std::uint64_t seed) : m_seed(seed) {
+    m_acc[0] = seed + Prime1 + Prime2;
+    m_acc[1] = seed + Prime2;
+    m_acc[2] = seed;
+    m_acc[3] = seed - Prime1;
+}
+
+void StateHasher::consume(const unsigned char* block) {
+    for (int i = 0; i < 4; ++i) m_acc[i] = round(m_acc[i], read64(block + i * 8));
+}
+
+void StateHasher::add(const void* data, std::size_t size) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    m_total += size;
+
+    if (m_buffered > 0) {
+        std::size_t take = std::min(size, sizeof(m_buffer) - m_buffered);
+        std::memcpy(m_buffer + m_buffered, p, take);
+        m_buffered += take;
+        p += take;
+        size -= take;
+        if (m_buffered < sizeof(m_buffer)) return;
+        consume(m_buffer);
+        m_buffered = 0;
+    }
+    for (; size >= 32; p += 32, size -= 32) consume(p);
+    std::memcpy(m_buffer, p, size);
+    m_buffered = size;
+}
+
+std::uint64_t StateHasher::digest() const {
+    std::uint64_t h;
+    if (m_total >= 32) {
+        h = rotl(m_acc[0], 1) + rotl(m_acc[1], 7) + rotl(m_acc[2], 12) + rotl(m_acc[3], 18);
+        for (int i = 0; i < 4; ++i) h = mergeRound(h, m_acc[i]);
+    }
+    else {
+        h = m_seed + Prime5;
+    }
+    h += m_total;
+
+    const unsigned char* p = m_buffer;
+    std::size_t left = m_buffered;
+    for (; left >= 8; p += 8, left -= 8) {
+        h ^= round(0, read64(p));
+        h = rotl(h, 27) * Prime1 + Prime4;
+    }
+    if (left >= 4) {
+        h ^= static_cast<std::uint64_t>(read32(p)) * Prime1;
+        h = rotl(h, 23) * Prime2 + Prime3;
+        p += 4;
+        left -= 4;
+    }
+    for (; left > 0; ++p, --left) {
+        h ^= *p * Prime5;
+        h = rotl(h, 11) * Prime1;
+    }
+
+    h ^= h >> 33;
+    h *= Prime2;
+    h ^= h >> 29;
+    h *= Prime3;
+    h ^= h >> 32;
+    return h;
+}
+
+bool StateHashLog::saveToFile(const std::string& path) const {
+    if (m_first != 0) {
+        std::cerr << "Not writing " << path << ": the hash log starts at tick " << m_first << '\n';
+        return false;
+    }
+    std::ofstream out(path, std::ios::binary);
+    if (not out) {
+        std::cerr << "Failed to write " << path << '\n';
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(m_hashes.data()), static_cast<std::streamsize>(m_hashes.size() * sizeof(std::uint64_t)));
+    return static_cast<bool>(out);
+}
+
+bool StateHashLog::loadFromFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (not in) {
+        std::cerr << "Failed to load " << path << '\n';
+        return false;
+    }
+    std::streamsize bytes = in.tellg();
+    in.seekg(0);
+    m_first = 0;
+    m_hashes.resize(static_cast<std::size_t>(bytes) / sizeof(std::uint64_t));
+    in.read(reinterpret_cast<char*>(m_hashes.data()), static_cast<std::streamsize>(m_hashes.size() * sizeof(std::uint64_t)));
+    return static_cast<bool>(in);
+}
+
+long long StateHashLog::firstDivergence(const StateHashLog& other) const {
+    const std::uint64_t begin = std::max(m_first, other.m_first);
+    const std::uint64_t end = std::min(m_first + m_hashes.size(), other.m_first + other.m_hashes.size());
+    for (std::uint64_t tick = begin; tick < end; ++tick)
+        if (m_hashes[tick - m_first] != other.m_hashes[tick - other.m_first]) return static_cast<long long>(tick);
+    return -1;
+}
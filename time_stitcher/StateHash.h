@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Streaming 64-bit hash of simulation state (the XXH64 algorithm). Fed with the raw bytes of
+// the state arrays once per tick; two runs with the same inputs must produce the same hashes.
+class StateHasher {
+public:
+    explicit StateHasher(std::uint64_t seed = 0);
+
+    void add(const void* data, std::size_t size);
+
+    template <typename T>
+    void add(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        add(&value, sizeof(T));
+    }
+    // only for arrays of types without padding
+    template <typename T>
+    void add(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        add(values.data(), values.size() * sizeof(T));
+    }
+
+    std::uint64_t digest() const;
+
+private:
+    void consume(const unsigned char* block);
+
+    std::uint64_t m_acc[4];
+    unsigned char m_buffer[32];
+    std::size_t m_buffered = 0;
+    std::uint64_t m_total = 0;
+    std::uint64_t m_seed;
+};
+
+// Hashes of the ticks of a run, by tick. Saved runs can be compared to find the first tick at
+// which an optimized code path stopped matching the reference path. The Debug build keeps the
+// whole run (saved to state_hashes.bin on exit); otherwise only the last Kept ticks or more.
+class StateHashLog {
+public:
+#ifdef _DEBUG
+    static constexpr std::size_t Kept = 0; // everything
+#else
+    static constexpr std::size_t Kept = 8192;
+#endif
+
+    StateHashLog() { m_hashes.reserve(2 * Kept); }
+
+    void clear() {
+        m_hashes.clear();
+        m_first = 0;
+    }
+    void push(std::uint64_t hash) {
+        if (Kept != 0 and m_hashes.size() == 2 * Kept) {
+            // drops the older half at once: amortized O(1), and the hashes stay contiguous
+            m_hashes.erase(m_hashes.begin(), m_hashes.begin() + Kept);
+            m_first += Kept;
+        }
+        m_hashes.push_back(hash);
+    }
+    std::size_t size() const { return m_hashes.size(); }
+    std::uint64_t last() const { return m_hashes.empty() ? 0 : m_hashes.back(); }
+    // tick of hashes()[0]
+    std::uint64_t firstTick() const { return m_first; }
+    const std::vector<std::uint64_t>& hashes() const { return m_hashes; }
+    void assign(std::uint64_t firstTick, const std::uint64_t* hashes, std::size_t count) {
+        m_hashes.assign(hashes, hashes + count);
+        m_first = firstTick;
+    }
+
+    // from tick 0; false if the log doesn't go back that far
+    bool saveToFile(const std::string& path) const;
+    bool loadFromFile(const std::string& path);
+
+    // first tick present in both logs whose hashes differ, -1 if they agree
+    long long firstDivergence(const StateHashLog& other) const;
+
+private:
+    std::vector<std::uint64_t> m_hashes;
+    std::uint64_t m_first = 0;
+};
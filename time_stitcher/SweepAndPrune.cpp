@@ -0,0 +1,162 @@
+#include "SweepAndPrune.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+    // at equal values a min sorts before a max, so boxes that touch overlap
+    struct Order {
+        float value;
+        bool max;
+        bool operator<(const Order& o) const { return value < o.value or (value == o.value and not max and o.max); }
+    };
+}
+
+std::uint32_t SweepAndPrune::add(const sf::FloatRect& box, std::uint32_t userData) {
+    std::uint32_t id;
+    if (not m_free.empty()) {
+        id = m_free.back();
+        m_free.pop_back();
+        m_boxes[id] = Box::of(box);
+        m_userData[id] = userData;
+    }
+    else {
+        id = static_cast<std::uint32_t>(m_boxes.size());
+        m_boxes.push_back(Box::of(box));
+        m_userData.push_back(userData);
+    }
+    // appended past everything; the next update() sorts them in from the right, so the new
+    // min passes every max that could overlap it
+    const float end = std::numeric_limits<float>::max();
+    for (auto& ends : m_ends) {
+        ends.push_back({ end, id << 1 });
+        ends.push_back({ end, id << 1 | 1u });
+    }
+    ++m_pending;
+    return id;
+}
+
+void SweepAndPrune::remove(std::uint32_t id) {
+    for (auto it = m_pairs.begin(); it != m_pairs.end();) {
+        const auto a = static_cast<std::uint32_t>(*it >> 32), b = static_cast<std::uint32_t>(*it);
+        if (a == id or b == id) {
+            m_removed.push_back({ a, b });
+            it = m_pairs.erase(it);
+        }
+        else ++it;
+    }
+    for (auto& ends : m_ends)
+        std::erase_if(ends, [id](const Endpoint& e) { return e.id() == id; });
+    m_retired.push_back(id);
+}
+
+void SweepAndPrune::clear() {
+    m_boxes.clear();
+    m_userData.clear();
+    m_free.clear();
+    m_retired.clear();
+    for (auto& ends : m_ends) ends.clear();
+    m_pairs.clear();
+    m_pending = 0;
+    clearEvents();
+}
+
+void SweepAndPrune::reserve(std::size_t boxes) {
+    m_boxes.reserve(boxes);
+    m_userData.reserve(boxes);
+    m_free.reserve(boxes);
+    m_retired.reserve(boxes);
+    for (auto& ends : m_ends) ends.reserve(2 * boxes);
+}
+
+bool SweepAndPrune::overlaps(std::uint32_t a, std::uint32_t b) const {
+    const Box& p = m_boxes[a];
+    const Box& q = m_boxes[b];
+    return p.min[0] <= q.max[0] and q.min[0] <= p.max[0] and p.min[1] <= q.max[1] and q.min[1] <= p.max[1];
+}
+
+void SweepAndPrune::update() {
+    // each new box sorted in from the right passes about half of all endpoints; many at once
+    // (the first fill, a loaded game) are cheaper to sort and sweep from scratch
+    const bool many = m_pending > 64 and m_pending * 4 > size();
+    m_pending = 0;
+    if (many) {
+        rebuild();
+        return;
+    }
+    sortAxis(0);
+    sortAxis(1);
+}
+
+void SweepAndPrune::refresh(int axis) {
+    for (Endpoint& e : m_ends[axis]) {
+        const Box& box = m_boxes[e.id()];
+        e.value = e.isMax() ? box.max[axis] : box.min[axis];
+    }
+}
+
+void SweepAndPrune::rebuild() {
+    for (int axis = 0; axis < 2; ++axis) {
+        refresh(axis);
+        std::sort(m_ends[axis].begin(), m_ends[axis].end(), [](const Endpoint& a, const Endpoint& b) {
+            return Order{ a.value, a.isMax() } < Order{ b.value, b.isMax() };
+        });
+    }
+
+    // sweep along x with the boxes open at that point, test y against each of them
+    std::pmr::unordered_set<std::uint64_t> pairs(&m_pairMemory);
+    pairs.reserve(m_pairs.size());
+    std::vector<std::uint32_t> open;
+    std::vector<std::uint32_t> slot(m_boxes.size());
+    for (const Endpoint& e : m_ends[0]) {
+        const std::uint32_t id = e.id();
+        if (e.isMax()) {
+            // swap-remove from the open list
+            const std::uint32_t last = open.back();
+            open[slot[id]] = last;
+            slot[last] = slot[id];
+            open.pop_back();
+            continue;
+        }
+        const Box& box = m_boxes[id];
+        for (std::uint32_t other : open) {
+            const Box& o = m_boxes[other];
+            if (box.min[1] <= o.max[1] and o.min[1] <= box.max[1]) pairs.insert(key(id, other));
+        }
+        slot[id] = static_cast<std::uint32_t>(open.size());
+        open.push_back(id);
+    }
+
+    for (std::uint64_t k : pairs)
+        if (not m_pairs.count(k)) m_added.push_back({ static_cast<std::uint32_t>(k >> 32), static_cast<std::uint32_t>(k) });
+    for (std::uint64_t k : m_pairs)
+        if (not pairs.count(k)) m_removed.push_back({ static_cast<std::uint32_t>(k >> 32), static_cast<std::uint32_t>(k) });
+    m_pairs.swap(pairs);
+}
+
+void SweepAndPrune::sortAxis(int axis) {
+    std::vector<Endpoint>& ends = m_ends[axis];
+    refresh(axis);
+
+    // insertion sort: every endpoint is swapped exactly with the endpoints it passed
+    for (std::size_t i = 1; i < ends.size(); ++i) {
+        const Endpoint moving = ends[i];
+        const Order order{ moving.value, moving.isMax() };
+        std::size_t j = i;
+        for (; j > 0 and order < Order{ ends[j - 1].value, ends[j - 1].isMax() }; --j) {
+            const Endpoint& passed = ends[j - 1];
+            const std::uint32_t a = moving.id(), b = passed.id();
+            if (not moving.isMax() and passed.isMax()) {
+                // a now starts before b ends: overlapping on this axis, maybe on both
+                if (overlaps(a, b) and m_pairs.insert(key(a, b)).second)
+                    m_added.push_back({ std::min(a, b), std::max(a, b) });
+            }
+            else if (moving.isMax() and not passed.isMax()) {
+                // a now ends before b starts: apart
+                if (m_pairs.erase(key(a, b)))
+                    m_removed.push_back({ std::min(a, b), std::max(a, b) });
+            }
+            ends[j] = passed;
+        }
+        ends[j] = moving;
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <cstdint>
+#include <memory_resource>
+#include <unordered_set>
+#include <vector>
+
+// Incremental sweep and prune for many moving boxes against each other. Both axes keep a sorted
+// array of box endpoints; update() refreshes the values and insertion sorts them again, which
+// is nearly linear when boxes moved little since the last update. Every swap of a min with a
+// max endpoint is a pair starting or stopping to overlap on that axis, so the set of
+// overlapping pairs is kept up to date from the swaps alone, with added/removed events.
+// Touching boxes overlap.
+class SweepAndPrune {
+public:
+    struct Pair {
+        std::uint32_t a, b; // ids, a < b
+    };
+
+    std::uint32_t add(const sf::FloatRect& box, std::uint32_t userData);
+    // removed events for its pairs are emitted at once; the id is only reused after
+    // clearEvents(), so the events still name the removed box's user data
+    void remove(std::uint32_t id);
+    // takes effect in the next update()
+    void move(std::uint32_t id, const sf::FloatRect& box) { m_boxes[id] = Box::of(box); }
+    void update();
+    void clear();
+    void reserve(std::size_t boxes);
+
+    std::uint32_t userData(std::uint32_t id) const { return m_userData[id]; }
+    std::size_t size() const { return m_boxes.size() - m_free.size() - m_retired.size(); }
+
+    // pairs that started / stopped overlapping since clearEvents()
+    const std::vector<Pair>& added() const { return m_added; }
+    const std::vector<Pair>& removed() const { return m_removed; }
+    void clearEvents() {
+        m_added.clear();
+        m_removed.clear();
+        m_free.insert(m_free.end(), m_retired.begin(), m_retired.end());
+        m_retired.clear();
+    }
+
+    std::size_t pairCount() const { return m_pairs.size(); }
+    bool overlapping(std::uint32_t a, std::uint32_t b) const { return m_pairs.count(key(a, b)) != 0; }
+
+private:
+    struct Box {
+        float min[2], max[2];
+        static Box of(const sf::FloatRect& r) {
+            return { { r.position.x, r.position.y }, { r.position.x + r.size.x, r.position.y + r.size.y } };
+        }
+    };
+    struct Endpoint {
+        float value;
+        std::uint32_t data; // id << 1 | is max
+        std::uint32_t id() const { return data >> 1; }
+        bool isMax() const { return data & 1u; }
+    };
+
+    static std::uint64_t key(std::uint32_t a, std::uint32_t b) {
+        return a < b ? (std::uint64_t{ a } << 32 | b) : (std::uint64_t{ b } << 32 | a);
+    }
+    bool overlaps(std::uint32_t a, std::uint32_t b) const;
+    void refresh(int axis);
+    void sortAxis(int axis);
+    void rebuild();
+
+    std::vector<Box> m_boxes;
+    std::vector<std::uint32_t> m_userData;
+    std::vector<std::uint32_t> m_free;
+    std::vector<std::uint32_t> m_retired; // removed since the last clearEvents()
+    std::vector<Endpoint> m_ends[2];
+    std::size_t m_pending = 0; // boxes added since the last update
+    // pair nodes come from a pool: pairs start and stop all the time, after warm-up that
+    // doesn't touch the heap
+    std::pmr::unsynchronized_pool_resource m_pairMemory;
+    std::pmr::unordered_set<std::uint64_t> m_pairs{ &m_pairMemory };
+    std::vector<Pair> m_added;
+    std::vector<Pair> m_removed;
+};
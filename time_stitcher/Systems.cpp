@@ -0,0 +1,208 @@
+#include "Systems.h"
+#include "Obstacle.h"
+#include <cmath>
+
+namespace {
+    sf::FloatRect box(const sf::Vector2f& center, const Collider& collider) {
+        return sf::FloatRect(center - collider.halfSize, collider.halfSize * 2.f);
+    }
+}
+
+Entity systems::spawnEcho(Registry& registry, SweepAndPrune& movers, AnimationBatch& batch, sf::Vector2f position,
+                          std::uint32_t clip, sf::Color tint) {
+    const Collider collider{ { 20.f, 20.f } };
+    Entity e = registry.create();
+    registry.emplace<Position>(e, position);
+    registry.emplace<Velocity>(e);
+    registry.emplace<Collider>(e, collider);
+    registry.emplace<Chaser>(e);
+    registry.emplace<SweepProxy>(e, movers.add(box(position, collider), e));
+    if (batch.animations() and batch.animations()->frameCount() > 0)
+        registry.emplace<Animated>(e, batch.add(clip, position, collider.halfSize * 2.f, tint));
+    return e;
+}
+
+void systems::despawnEcho(Registry& registry, SweepAndPrune& movers, AnimationBatch& batch, Entity e) {
+    if (not registry.valid(e)) return;
+    // its pairs' removed events reach collideMovers with the entity gone, only the partners count down
+    if (const SweepProxy* proxy = registry.tryGet<SweepProxy>(e)) movers.remove(proxy->id);
+    if (const Animated* anim = registry.tryGet<Animated>(e)) batch.remove(anim->slot);
+    registry.destroy(e);
+}
+
+void systems::overlappingObstacles(Registry& registry, const AabbTree& tree, const sf::FloatRect& bounds, std::pmr::vector<Entity>& out) {
+    tree.query(bounds, [&](int proxy) {
+        Entity e = tree.userData(proxy);
+        if (registry.get<Obstacle>(e).intersects(bounds)) out.push_back(e);
+        return true;
+    });
+}
+
+void systems::overlappingObstacles(Registry& registry, const AabbTree& tree, const sf::FloatRect& bounds, const CollisionMask& mask,
+                                   sf::Vector2i maskTopLeft, std::pmr::vector<Entity>& out) {
+    tree.query(bounds, [&](int proxy) {
+        Entity e = tree.userData(proxy);
+        const Obstacle& obs = registry.get<Obstacle>(e);
+        if (obs.intersects(bounds) and obs.overlaps(mask, maskTopLeft)) out.push_back(e);
+        return true;
+    });
+}
+
+bool systems::touchObstacles(Registry& registry, const AabbTree& tree, const sf::FloatRect& bounds) {
+    bool hit = false;
+    tree.query(bounds, [&](int proxy) {
+        Obstacle& obs = registry.get<Obstacle>(tree.userData(proxy));
+        if (obs.intersects(bounds)) {
+            obs.touched();
+            hit = true;
+        }
+        return true;
+    });
+    return hit;
+}
+
+void systems::chase(Registry& registry, const FlowField& field, const Maze& maze, const Raycaster& sight, sf::Vector2f target,
+                     std::pmr::memory_resource* scratch) {
+    // a chaser in range runs straight at the target if its whole box can: one ray along each
+    // side of the box, all of them cast as one batch
+    constexpr float Range = Maze::TileSize * 8.f;
+    std::pmr::vector<Entity> near(scratch);
+    std::pmr::vector<Ray> rays(scratch);
+    registry.each<Chaser, Position, Collider>([&](Entity e, Chaser&, Position& pos, Collider& col) {
+        const sf::Vector2f to = target - pos.value;
+        const float len = std::sqrt(to.x * to.x + to.y * to.y);
+        if (len <= 0.f or len > Range) return;
+        const sf::Vector2f normal(-to.y / len, to.x / len);
+        const sf::Vector2f side = normal * (std::abs(normal.x) * col.halfSize.x + std::abs(normal.y) * col.halfSize.y);
+        near.push_back(e);
+        rays.push_back({ pos.value + side, target + side });
+        rays.push_back({ pos.value - side, target - side });
+    });
+    std::pmr::vector<RayHit> hits(rays.size(), scratch);
+    sight.cast(rays, hits);
+
+    // both passes walk the chasers in the same order
+    std::size_t next = 0;
+    registry.each<Chaser, Position, Velocity>([&](Entity e, Chaser& chaser, Position& pos, Velocity& vel) {
+        bool inSight = false;
+        if (next < near.size() and near[next] == e) {
+            inSight = not hits[2 * next].hit and not hits[2 * next + 1].hit;
+            ++next;
+        }
+        sf::Vector2f to = target - pos.value;
+        if (not inSight) {
+            sf::Vector2i tile = maze.tileAt(pos.value);
+            sf::Vector2i step = field.step(tile);
+            if (step == sf::Vector2i{ 0, 0 }) {
+                vel.value = { 0.f, 0.f };
+                return;
+            }
+            to = maze.tileCenter(tile + step) - pos.value;
+        }
+        float len = std::sqrt(to.x * to.x + to.y * to.y); // sqrt is exactly rounded, hypot isn't
+        // a crowd of echoes squeezes through a corridor one by one
+        const float speed = chaser.contacts > 0 ? chaser.speed * 0.5f : chaser.speed;
+        vel.value = len > 0.f ? to * (speed / len) : sf::Vector2f{ 0.f, 0.f };
+    });
+}
+
+void systems::move(Registry& registry, const ChunkWorld& world, const AabbTree& obstacles, float dt) {
+    registry.each<Velocity, Position, Collider>([&](Entity, Velocity& vel, Position& pos, Collider& col) {
+        if (vel.value == sf::Vector2f{ 0.f, 0.f }) return;
+        // resolve the axes separately so movers slide along walls
+        sf::Vector2f next = pos.value;
+        next.x += vel.value.x * dt;
+        if (world.collides(box(next, col)) or touchObstacles(registry, obstacles, box(next, col))) next.x = pos.value.x;
+        next.y += vel.value.y * dt;
+        if (world.collides(box(next, col)) or touchObstacles(registry, obstacles, box(next, col))) next.y = pos.value.y;
+        pos.value = next;
+    });
+}
+
+void systems::collideMovers(Registry& registry, SweepAndPrune& movers) {
+    registry.each<SweepProxy, Position, Collider>([&](Entity, SweepProxy& proxy, Position& pos, Collider& col) {
+        movers.move(proxy.id, box(pos.value, col));
+    });
+    movers.update();
+
+    auto count = [&](std::uint32_t id, int delta) {
+        Entity e = movers.userData(id);
+        if (registry.has<Chaser>(e)) registry.get<Chaser>(e).contacts += delta;
+    };
+    for (const SweepAndPrune::Pair& pair : movers.added()) {
+        count(pair.a, 1);
+        count(pair.b, 1);
+    }
+    for (const SweepAndPrune::Pair& pair : movers.removed()) {
+        count(pair.a, -1);
+        count(pair.b, -1);
+    }
+    movers.clearEvents();
+}
+
+void systems::touchEffects(Registry& registry, ParticleSystem& particles, const ParticleEffect& effect) {
+    registry.each<Obstacle>([&](Entity, Obstacle& obs) {
+        if (obs.m_touchTicks == Obstacle::TouchTicks) particles.burst(obs.getBounds().getCenter(), effect);
+    });
+}
+
+void systems::obstacles(Registry& registry) {
+    registry.each<Obstacle>([&](Entity, Obstacle& obs) { obs.update(); });
+}
+
+void systems::updateObstacleTree(Registry& registry, AabbTree& tree) {
+    registry.each<Obstacle, TreeProxy>([&](Entity, Obstacle& obs, TreeProxy& proxy) {
+        tree.move(proxy.id, obs.getBounds());
+    });
+}
+
+void systems::animate(Registry& registry, AnimationBatch& batch, const Player& look, float dt) {
+    registry.each<Animated, Position, Velocity>([&](Entity, Animated& anim, Position& pos, Velocity& vel) {
+        batch.setPosition(anim.slot, pos.value);
+        batch.play(anim.slot, look.clipFor(vel.value));
+    });
+    batch.update(dt);
+}
+
+void systems::hashState(Registry& registry, StateHasher& hasher) {
+    hasher.add(registry.pool<Position>().entities());
+    hasher.add(registry.pool<Position>().components());
+    hasher.add(registry.pool<Velocity>().entities());
+    hasher.add(registry.pool<Velocity>().components());
+    registry.each<Obstacle>([&](Entity e, Obstacle& obs) {
+        hasher.add(e);
+        hasher.add(obs.m_touchTicks);
+        hasher.add(obs.m_collidable);
+        hasher.add(obs.m_didTouch);
+    });
+}
+
+void systems::recordTimeline(Registry& registry, ObstacleStore& store) {
+    registry.each<TimelineSlot, Obstacle>([&](Entity, TimelineSlot& slot, Obstacle& obs) {
+        store.set(slot.index, { obs.getBounds().getCenter(), obs.m_collidable });
+    });
+}
+
+void systems::applyTimeline(Registry& registry, const ObstacleStore& store) {
+    registry.each<TimelineSlot, Obstacle>([&](Entity, TimelineSlot& slot, Obstacle& obs) {
+        if (slot.index >= store.size()) return;
+        bool collidable = store.get(slot.index).collidable;
+        if (collidable != obs.m_collidable) obs.setCollideable(collidable);
+    });
+}
+
+void systems::drawObstacles(Registry& registry, sf::RenderTarget& target) {
+    registry.each<Obstacle>([&](Entity, Obstacle& obs) { obs.draw(target); });
+}
+
+void systems::drawChasers(Registry& registry, sf::RenderTarget& target, sf::VertexArray& batch) {
+    batch.setPrimitiveType(sf::PrimitiveType::Triangles);
+    batch.clear();
+    const sf::Color color(180, 80, 255, 200);
+    registry.each<Chaser, Position, Collider>([&](Entity, Chaser&, Position& pos, Collider& col) {
+        sf::Vector2f a = pos.value - col.halfSize, c = pos.value + col.halfSize;
+        sf::Vector2f b{ c.x, a.y }, d{ a.x, c.y };
+        for (const sf::Vector2f& p : { a, b, c, a, c, d }) batch.append(sf::Vertex{ p, color });
+    });
+    if (batch.getVertexCount() > 0) target.draw(batch);
+}
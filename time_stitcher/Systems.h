@@ -0,0 +1,73 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <memory_resource>
+#include <vector>
+#include "AnimationBatch.h"
+#include "ChunkWorld.h"
+#include "Components.h"
+#include "Ecs.h"
+#include "FlowField.h"
+#include "Maze.h"
+#include "Particles.h"
+#include "Player.h"
+#include "Raycaster.h"
+#include "StateHash.h"
+#include "CollisionMask.h"
+#include "AabbTree.h"
+#include "SweepAndPrune.h"
+#include "Timeline.h"
+
+// Game logic as functions over Registry components. Called from Game::update/render in order;
+// structural changes are deferred and flushed by the caller once all systems ran.
+namespace systems {
+    // a chaser with its mover proxy and, when the batch has frames, an animated quad
+    Entity spawnEcho(Registry& registry, SweepAndPrune& movers, AnimationBatch& batch, sf::Vector2f position,
+                     std::uint32_t clip, sf::Color tint);
+    // destroys an echo and hands its proxy and quad back for later spawns (not while iterating)
+    void despawnEcho(Registry& registry, SweepAndPrune& movers, AnimationBatch& batch, Entity e);
+
+    // collects the collidable obstacles overlapping `bounds` (out is usually frame-arena backed);
+    // candidates come from the obstacle tree, user data of a proxy is its entity
+    void overlappingObstacles(Registry& registry, const AabbTree& tree, const sf::FloatRect& bounds, std::pmr::vector<Entity>& out);
+    // same, then keeps only the obstacles whose solid pixels touch the mask's
+    void overlappingObstacles(Registry& registry, const AabbTree& tree, const sf::FloatRect& bounds, const CollisionMask& mask,
+                              sf::Vector2i maskTopLeft, std::pmr::vector<Entity>& out);
+
+    // touches every obstacle overlapping `bounds`; true if any did (the mover has to step back)
+    bool touchObstacles(Registry& registry, const AabbTree& tree, const sf::FloatRect& bounds);
+
+    // chasers steer towards the centre of the next tile of the flow field, or straight at the
+    // target when it is close and nothing blocks the way (scratch backs the ray batch)
+    void chase(Registry& registry, const FlowField& field, const Maze& maze, const Raycaster& sight, sf::Vector2f target,
+               std::pmr::memory_resource* scratch);
+
+    // integrates velocities, an axis that would run into a wall or obstacle is cancelled
+    void move(Registry& registry, const ChunkWorld& world, const AabbTree& obstacles, float dt);
+
+    // movers against each other: syncs their boxes into the sweep and prune and turns its pair
+    // events into contact counts, like touched()/update() of obstacles; crowded chasers slow down
+    void collideMovers(Registry& registry, SweepAndPrune& movers);
+
+    // a burst at every obstacle touched this tick, by whoever; before obstacles() runs the timers
+    void touchEffects(Registry& registry, ParticleSystem& particles, const ParticleEffect& effect);
+    // obstacle touch timers, once per tick
+    void obstacles(Registry& registry);
+    // moves the tree proxies of obstacles that left their fat box
+    void updateObstacleTree(Registry& registry, AabbTree& tree);
+
+    // moves animated quads to their entity and faces them along their velocity like the player,
+    // then advances all animations of the batch at once
+    void animate(Registry& registry, AnimationBatch& batch, const Player& look, float dt);
+
+    // entity ids, positions, velocities and obstacle state
+    void hashState(Registry& registry, StateHasher& hasher);
+
+    // writes obstacle state into the current branch (unchanged states keep sharing with its parent)
+    void recordTimeline(Registry& registry, ObstacleStore& store);
+    // puts obstacles back into the state a branch remembers
+    void applyTimeline(Registry& registry, const ObstacleStore& store);
+
+    void drawObstacles(Registry& registry, sf::RenderTarget& target);
+    // all chasers as one vertex array
+    void drawChasers(Registry& registry, sf::RenderTarget& target, sf::VertexArray& batch);
+}
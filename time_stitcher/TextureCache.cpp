@@ -0,0 +1,45 @@
+#include "TextureCache.h"
+#include "MemoryTracker.h"
+#include <iostream>
+
+const sf::Texture* TextureCache::get(const std::string& path, bool smooth, bool repeated) {
+    auto it = m_textures.find(path);
+    if (it != m_textures.end()) return it->second.get();
+
+    auto texture = std::make_unique<sf::Texture>();
+    if (not texture->loadFromFile(path)) {
+        std::cerr << "Failed to load texture: " << path << '\n';
+        texture.reset();
+    }
+    else {
+        texture->setSmooth(smooth);
+        texture->setRepeated(repeated);
+    }
+    return m_textures.emplace(path, std::move(texture)).first->second.get();
+}
+
+
+const std::string& TextureCache::pathOf(const sf::Texture* texture) const {
+    static const std::string none;
+    if (not texture) return none;
+    for (const auto& [path, cached] : m_textures)
+        if (cached.get() == texture) return path;
+    return none;
+}
+
+const CollisionMask* TextureCache::maskOf(const sf::Texture* texture) {
+    if (not texture) return nullptr;
+    auto it = m_masks.find(texture);
+    if (it == m_masks.end()) {
+        sf::Image image = texture->copyToImage();
+        it = m_masks.emplace(texture, CollisionMask::fromImage(image, sf::IntRect({ 0, 0 }, sf::Vector2i(image.getSize())))).first;
+    }
+    return &it->second;
+}
+
+std::size_t TextureCache::bytes() const {
+    std::size_t total = 0;
+    for (const auto& [path, texture] : m_textures)
+        if (texture) total += memory::textureBytes(*texture);
+    return total;
+}
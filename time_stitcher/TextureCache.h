@@ -0,0 +1,31 @@
+#pragma once
+#include <SFML/Graphics/Texture.hpp>
+#include "CollisionMask.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Loads every texture file once and hands out shared pointers to it, so entities reference
+// a texture instead of owning a copy. Failed loads are remembered (nullptr) and not retried.
+class TextureCache {
+public:
+    // the flags only apply to the first load of a path
+    const sf::Texture* get(const std::string& path, bool smooth = true, bool repeated = false);
+
+    // path a texture was loaded from, empty if it isn't from this cache
+    const std::string& pathOf(const sf::Texture* texture) const;
+    // alpha mask of a texture (unscaled), built on first use; nullptr if there is no texture
+    const CollisionMask* maskOf(const sf::Texture* texture);
+
+    std::size_t size() const { return m_textures.size(); }
+    // estimated video memory of all loaded textures
+    std::size_t bytes() const;
+    void clear() {
+        m_masks.clear();
+        m_textures.clear();
+    }
+
+private:
+    std::unordered_map<std::string, std::unique_ptr<sf::Texture>> m_textures;
+    std::unordered_map<const sf::Texture*, CollisionMask> m_masks;
+};
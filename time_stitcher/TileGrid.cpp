@@ -0,0 +1,27 @@
+#include "TileGrid.h"
+#include "Maze.h"
+
+TileGrid::TileGrid(int width, int height)
+    : m_width(width), m_height(height), m_words((width + 63) / 64),
+    m_bits(static_cast<std::size_t>(m_words) * height, 0)
+{
+}
+
+TileGrid TileGrid::fromMaze(const Maze& maze) {
+    TileGrid grid(maze.width(), maze.height());
+    for (int y = 0; y < grid.m_height; ++y) {
+        std::uint64_t* words = grid.m_bits.data() + static_cast<std::size_t>(y) * grid.m_words;
+        for (int x = 0; x < grid.m_width; ++x) {
+            if (maze.isWall(x, y)) words[x >> 6] |= std::uint64_t{ 1 } << (x & 63);
+        }
+    }
+    return grid;
+}
+
+void TileGrid::set(int x, int y, bool wall) {
+    if (not inside(x, y)) return;
+    std::uint64_t& word = m_bits[static_cast<std::size_t>(y) * m_words + (x >> 6)];
+    std::uint64_t mask = std::uint64_t{ 1 } << (x & 63);
+    if (wall) word |= mask;
+    else word &= ~mask;
+}
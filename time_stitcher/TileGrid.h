@@ -0,0 +1,40 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+
+class Maze;
+
+// Bit-packed occupancy bitmap of the maze: one bit per tile, set = wall.
+// Rows are padded to whole 64 bit words. Everything outside the grid counts as blocked.
+class TileGrid {
+public:
+    TileGrid() = default;
+    TileGrid(int width, int height);
+
+    // rasterizes the whole maze
+    static TileGrid fromMaze(const Maze& maze);
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    bool empty() const { return m_width == 0 or m_height == 0; }
+
+    bool inside(int x, int y) const { return x >= 0 and y >= 0 and x < m_width and y < m_height; }
+    bool blocked(int x, int y) const {
+        if (not inside(x, y)) return true;
+        return (m_bits[static_cast<std::size_t>(y) * m_words + (x >> 6)] >> (x & 63)) & 1u;
+    }
+    bool walkable(int x, int y) const { return not blocked(x, y); }
+    bool walkable(const sf::Vector2i& t) const { return not blocked(t.x, t.y); }
+    void set(int x, int y, bool wall);
+
+    // raw row access (word w holds tiles [64w, 64w + 63])
+    const std::uint64_t* row(int y) const { return m_bits.data() + static_cast<std::size_t>(y) * m_words; }
+    int wordsPerRow() const { return m_words; }
+
+private:
+    int m_width = 0;
+    int m_height = 0;
+    int m_words = 0;
+    std::vector<std::uint64_t> m_bits;
+};
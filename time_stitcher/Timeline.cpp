@@ -0,0 +1,179 @@
+#include "Timeline.h"
+#include <algorithm>
+
+ObstacleStore::Node& ObstacleStore::writable(NodePtr& p) {
+    if (p.use_count() != 1) p = std::make_shared<Node>(*p);
+    return *p;
+}
+
+ObstacleStore::NodePtr ObstacleStore::lift(NodePtr node, int from, int to) {
+    for (; node and from < to; ++from) {
+        auto parent = std::make_shared<Node>();
+        parent->children.push_back(std::move(node));
+        node = std::move(parent);
+    }
+    return node;
+}
+
+const ObstacleState& ObstacleStore::get(std::size_t i) const {
+    const Node* node = m_root.get();
+    for (int h = m_height; h > 0; --h)
+        node = node->children[(i >> shiftAt(h)) & ((1u << InnerBits) - 1)].get();
+    return node->items[i & ((1u << LeafBits) - 1)];
+}
+
+void ObstacleStore::set(std::size_t i, const ObstacleState& state) {
+    // writing the same value must not unshare anything
+    if (get(i) == state) return;
+    NodePtr* p = &m_root;
+    for (int h = m_height; h > 0; --h)
+        p = &writable(*p).children[(i >> shiftAt(h)) & ((1u << InnerBits) - 1)];
+    writable(*p).items[i & ((1u << LeafBits) - 1)] = state;
+}
+
+std::uint32_t ObstacleStore::push_back(const ObstacleState& state) {
+    if (not m_root) {
+        m_root = std::make_shared<Node>();
+        m_height = 0;
+    }
+    else if (m_size == capacity()) {
+        m_root = lift(std::move(m_root), m_height, m_height + 1);
+        ++m_height;
+    }
+
+    NodePtr* p = &m_root;
+    for (int h = m_height; h > 0; --h) {
+        Node& node = writable(*p);
+        std::size_t c = (m_size >> shiftAt(h)) & ((1u << InnerBits) - 1);
+        if (c == node.children.size()) node.children.push_back(std::make_shared<Node>());
+        p = &node.children[c];
+    }
+    Node& leaf = writable(*p);
+    if (leaf.items.empty()) leaf.items.reserve(std::size_t{ 1 } << LeafBits);
+    leaf.items.push_back(state);
+    return static_cast<std::uint32_t>(m_size++);
+}
+
+void ObstacleStore::clear() {
+    m_root.reset();
+    m_size = 0;
+    m_height = 0;
+}
+
+void ObstacleStore::diffNode(const Node* a, const Node* b, int height, std::size_t first, const std::function<void(std::size_t)>& fn) {
+    if (a == b) return;
+    if (height == 0) {
+        std::size_t na = a ? a->items.size() : 0, nb = b ? b->items.size() : 0;
+        for (std::size_t i = 0; i < std::max(na, nb); ++i)
+            if (i >= na or i >= nb or a->items[i] != b->items[i]) fn(first + i);
+        return;
+    }
+    std::size_t ca = a ? a->children.size() : 0, cb = b ? b->children.size() : 0;
+    for (std::size_t c = 0; c < std::max(ca, cb); ++c)
+        diffNode(c < ca ? a->children[c].get() : nullptr, c < cb ? b->children[c].get() : nullptr,
+                 height - 1, first + (c << shiftAt(height)), fn);
+}
+
+void ObstacleStore::diff(const ObstacleStore& a, const ObstacleStore& b, const std::function<void(std::size_t)>& fn) {
+    int height = std::max(a.m_height, b.m_height);
+    NodePtr ra = lift(a.m_root, a.m_height, height);
+    NodePtr rb = lift(b.m_root, b.m_height, height);
+    diffNode(ra.get(), rb.get(), height, 0, fn);
+}
+
+void ObstacleStore::mergeNode(NodePtr& ours, const Node* base, const NodePtr& theirsPtr, int height, std::size_t first,
+                              std::size_t limit, MergeStats& stats) {
+    const Node* theirs = theirsPtr.get();
+    // theirs didn't touch this subtree, or we already have their version
+    if (theirs == base or theirs == ours.get() or not ours or first >= limit) return;
+
+    // we didn't touch it either: share their subtree as is
+    const std::size_t span = std::size_t{ 1 } << (LeafBits + InnerBits * height);
+    if (ours.get() == base and first + span <= limit) {
+        diffNode(base, theirs, height, first, [&](std::size_t) { ++stats.changed; });
+        ours = theirsPtr;
+        return;
+    }
+
+    if (height == 0) {
+        std::size_t n = std::min({ limit - first, theirs->items.size(), base->items.size() });
+        Node* node = nullptr;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (theirs->items[i] == base->items[i]) continue;
+            if (not node) node = &writable(ours);
+            ObstacleState& mine = node->items[i];
+            if (mine != base->items[i] and mine != theirs->items[i]) ++stats.conflicts;
+            mine = theirs->items[i];
+            ++stats.changed;
+        }
+        return;
+    }
+
+    Node& node = writable(ours);
+    std::size_t count = std::min({ node.children.size(), theirs->children.size(), base->children.size() });
+    for (std::size_t c = 0; c < count; ++c)
+        mergeNode(node.children[c], base->children[c].get(), theirs->children[c], height - 1,
+                  first + (c << shiftAt(height)), limit, stats);
+}
+
+ObstacleStore::MergeStats ObstacleStore::merge(const ObstacleStore& base, const ObstacleStore& theirs) {
+    MergeStats stats;
+    // `base` is the fork point of both sides, so its states exist in ours and theirs
+    const std::size_t limit = std::min({ base.m_size, m_size, theirs.m_size });
+    if (limit > 0) {
+        int height = std::max({ m_height, base.m_height, theirs.m_height });
+        m_root = lift(std::move(m_root), m_height, height);
+        m_height = height;
+        NodePtr rb = lift(base.m_root, base.m_height, height);
+        NodePtr rt = lift(theirs.m_root, theirs.m_height, height);
+        mergeNode(m_root, rb.get(), rt, height, 0, limit, stats);
+    }
+    for (std::size_t i = base.m_size; i < theirs.m_size; ++i) {
+        push_back(theirs.get(i));
+        ++stats.appended;
+    }
+    return stats;
+}
+
+std::size_t ObstacleStore::countUnique(const Node* node, const Node* other, int height) {
+    if (not node or node == other) return 0;
+    std::size_t count = 1;
+    if (height > 0) {
+        std::size_t co = other ? other->children.size() : 0;
+        for (std::size_t c = 0; c < node->children.size(); ++c)
+            count += countUnique(node->children[c].get(), c < co ? other->children[c].get() : nullptr, height - 1);
+    }
+    return count;
+}
+
+std::size_t ObstacleStore::uniqueNodes(const ObstacleStore& other) const {
+    if (not m_root) return 0;
+    int height = std::max(m_height, other.m_height);
+    NodePtr mine = lift(m_root, m_height, height);
+    NodePtr theirs = lift(other.m_root, other.m_height, height);
+    // the lifted wrappers are temporary, only count real nodes
+    return countUnique(mine.get(), theirs.get(), height) - (height - m_height);
+}
+
+Timeline::BranchId Timeline::start(const sf::Vector2f& player) {
+    m_branches.clear();
+    Branch root;
+    root.player = player;
+    m_branches.push_back(std::move(root));
+    return 0;
+}
+
+Timeline::BranchId Timeline::fork(BranchId from) {
+    Branch child;
+    child.obstacles = m_branches[from].obstacles;
+    child.base = m_branches[from].obstacles;
+    child.player = m_branches[from].player;
+    child.parent = from;
+    m_branches.push_back(std::move(child));
+    return static_cast<BranchId>(m_branches.size() - 1);
+}
+
+ObstacleStore::MergeStats Timeline::merge(BranchId into, BranchId from) {
+    const Branch& source = m_branches[from];
+    return m_branches[into].obstacles.merge(source.base, source.obstacles);
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Everything about an obstacle that a timeline branch remembers.
+struct ObstacleState {
+    sf::Vector2f position;
+    bool collidable = true;
+
+    bool operator==(const ObstacleState&) const = default;
+};
+
+// Persistent array of obstacle states: a radix tree (64 states per leaf, 32 children per inner
+// node) whose nodes are shared between copies. Copying a store is O(1); a write copies only the
+// nodes on its path that are still shared, so memory grows with the number of changes.
+// Two stores forked from one another can be compared and merged by skipping shared subtrees.
+// Not thread-safe: sharing is detected through the node reference counts.
+class ObstacleStore {
+public:
+    static constexpr int LeafBits = 6;
+    static constexpr int InnerBits = 5;
+
+    struct MergeStats {
+        std::size_t changed = 0;    // states taken over from `theirs`
+        std::size_t conflicts = 0;  // changed on both sides (theirs wins)
+        std::size_t appended = 0;   // states only `theirs` has, added at the end
+    };
+
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    const ObstacleState& get(std::size_t i) const;
+    void set(std::size_t i, const ObstacleState& state);
+    std::uint32_t push_back(const ObstacleState& state);
+    void clear();
+
+    // calls fn(index) for every index whose state differs between a and b
+    // (including indices only one of them has); shared subtrees are skipped
+    static void diff(const ObstacleStore& a, const ObstacleStore& b, const std::function<void(std::size_t)>& fn);
+
+    // three-way merge: applies what `theirs` changed relative to `base` (their common fork point)
+    MergeStats merge(const ObstacleStore& base, const ObstacleStore& theirs);
+
+    // nodes not shared with `other`, a measure of how far two stores diverged
+    std::size_t uniqueNodes(const ObstacleStore& other) const;
+
+private:
+    struct Node {
+        std::vector<std::shared_ptr<Node>> children; // inner nodes
+        std::vector<ObstacleState> items;            // leaves
+    };
+    using NodePtr = std::shared_ptr<Node>;
+
+    static int shiftAt(int height) { return LeafBits + InnerBits * (height - 1); }
+    std::size_t capacity() const { return std::size_t{ 1 } << (LeafBits + InnerBits * m_height); }
+    // node `p` ready for writing: copied first if another store still shares it
+    static Node& writable(NodePtr& p);
+    static NodePtr lift(NodePtr node, int from, int to);
+
+    static void diffNode(const Node* a, const Node* b, int height, std::size_t first, const std::function<void(std::size_t)>& fn);
+    static void mergeNode(NodePtr& ours, const Node* base, const NodePtr& theirs, int height, std::size_t first,
+                          std::size_t limit, MergeStats& stats);
+    static std::size_t countUnique(const Node* node, const Node* other, int height);
+
+    NodePtr m_root;
+    std::size_t m_size = 0;
+    int m_height = 0; // inner levels above the leaves
+};
+
+// Branches of the world. Forking remembers the parent state as the branch's base, so a branch's
+// changes can later be merged into any other branch (usually a fresh fork of its parent).
+class Timeline {
+public:
+    using BranchId = std::uint32_t;
+    static constexpr BranchId NoBranch = ~BranchId{ 0 };
+
+    struct Branch {
+        ObstacleStore obstacles;
+        ObstacleStore base;          // obstacles of the parent when this branch was forked
+        sf::Vector2f player;
+        BranchId parent = NoBranch;
+    };
+
+    // drops all branches and starts a root branch
+    BranchId start(const sf::Vector2f& player);
+
+    // O(1): the new branch shares all state with `from`
+    BranchId fork(BranchId from);
+    ObstacleStore::MergeStats merge(BranchId into, BranchId from);
+
+    Branch& branch(BranchId id) { return m_branches[id]; }
+    const Branch& branch(BranchId id) const { return m_branches[id]; }
+    std::size_t branchCount() const { return m_branches.size(); }
+
+private:
+    std::vector<Branch> m_branches;
+};
@@ -0,0 +1,76 @@
+#include "Bench.h"
+#include "AabbTree.h"
+
+namespace {
+    struct Body {
+        sf::FloatRect box;
+        sf::Vector2f velocity;
+    };
+
+    bool touching(const sf::FloatRect& a, const sf::FloatRect& b) {
+        return a.position.x <= b.position.x + b.size.x and b.position.x <= a.position.x + a.size.x
+            and a.position.y <= b.position.y + b.size.y and b.position.y <= a.position.y + a.size.y;
+    }
+}
+
+// 50k boxes of 8..24 px in a 8000 x 8000 world, most of them moving at up to 2 px a frame:
+// building the tree, a frame of moves, and 1000 queries of a 256 x 256 screen sized area.
+BENCH("aabb tree: 50k boxes") {
+    constexpr int N = 50000;
+    constexpr int Queries = 1000;
+    bench::Random random;
+    std::vector<Body> bodies(N);
+    for (Body& body : bodies) {
+        const float size = random.range(8.f, 24.f);
+        body.box = { { random.range(0.f, 8000.f), random.range(0.f, 8000.f) }, { size, size } };
+        if (random.next() % 4 != 0) body.velocity = { random.range(-2.f, 2.f), random.range(-2.f, 2.f) };
+    }
+
+    AabbTree tree;
+    tree.reserve(N);
+    std::vector<int> proxies(N);
+    const double built = bench::seconds([&] {
+        tree.clear();
+        for (int i = 0; i < N; ++i) proxies[i] = tree.insert(bodies[i].box, static_cast<std::uint32_t>(i));
+    });
+    CHECK(tree.size() == static_cast<std::size_t>(N));
+    bench::report("insert 50k", built * 1e3, "ms");
+    bench::report("tree height", tree.height(), "levels");
+
+    // one second of frames; the first ones reinsert, then most moves stay inside the fat box
+    constexpr int Frames = 60;
+    std::size_t reinserted = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < Frames; ++f) {
+        for (int i = 0; i < N; ++i) {
+            Body& body = bodies[i];
+            body.box.position += body.velocity;
+            reinserted += tree.move(proxies[i], body.box, body.velocity);
+        }
+    }
+    const std::chrono::duration<double> moved = std::chrono::steady_clock::now() - start;
+    bench::report("move 50k, per frame", moved.count() * 1e3 / Frames, "ms");
+    bench::report("moves that reinsert", 100.0 * reinserted / (double(N) * Frames), "%");
+    CHECK(tree.height() < 40);
+
+    std::vector<sf::FloatRect> areas(Queries);
+    for (sf::FloatRect& area : areas) area = { { random.range(0.f, 7744.f), random.range(0.f, 7744.f) }, { 256.f, 256.f } };
+    std::size_t found = 0;
+    const double queried = bench::seconds([&] {
+        found = 0;
+        for (const sf::FloatRect& area : areas)
+            tree.query(area, [&](int) { ++found; return true; });
+    });
+    bench::report("query 256 x 256", queried * 1e6 / Queries, "us");
+    bench::report("fat boxes per query", double(found) / Queries, "");
+
+    // every real box overlapping an area is among the fat boxes found for it
+    bool complete = true;
+    for (int q = 0; q < 20; ++q) {
+        std::vector<char> seen(N, 0);
+        tree.query(areas[q], [&](int proxy) { seen[tree.userData(proxy)] = 1; return true; });
+        for (int i = 0; i < N; ++i)
+            if (touching(bodies[i].box, areas[q]) and not seen[i]) complete = false;
+    }
+    CHECK(complete);
+}
@@ -0,0 +1,68 @@
+#include "Bench.h"
+#include "AnimationBatch.h"
+
+// 50k animated quads on 4-frame clips at 60 fps: the batch's one pass over the instance arrays
+// against stepping an AnimationState per instance and rewriting that instance's own quad, as a
+// sprite per instance does (and then needs one draw call each instead of one in total).
+BENCH("animation: batch update against per instance state") {
+    constexpr int N = 50000;
+    constexpr int Frames = 120;
+    sf::Texture texture; // only referenced by the frames, never drawn
+    AnimationSet set;
+    for (int i = 0; i < 32; ++i) set.addFrame(texture, sf::IntRect({ i * 32, 0 }, { 32, 32 }));
+    for (int clip = 0; clip < 8; ++clip) set.addClip(clip * 4, 4, 0.1f);
+    bench::Random random;
+
+    AnimationBatch batch;
+    batch.setAnimations(&set);
+    batch.reserve(N);
+    std::vector<AnimationState> states(N);
+    std::vector<sf::Vector2f> positions(N);
+    for (int i = 0; i < N; ++i) {
+        const std::uint32_t clip = random.next() % 8;
+        positions[i] = { random.range(0.f, 2000.f), random.range(0.f, 2000.f) };
+        batch.add(clip, positions[i], { 40.f, 40.f });
+        animation::play(set, states[i], clip);
+    }
+    CHECK(batch.size() == static_cast<std::size_t>(N));
+
+    const double batched = bench::seconds([&] {
+        for (int f = 0; f < Frames; ++f) {
+            for (int i = 0; i < N; ++i) batch.setPosition(static_cast<std::uint32_t>(i), positions[i]);
+            batch.update(1.f / 60.f);
+        }
+    });
+    std::size_t changed = 0;
+    std::vector<sf::Vertex> quads(static_cast<std::size_t>(N) * 6);
+    const double single = bench::seconds([&] {
+        for (int f = 0; f < Frames; ++f) {
+            for (int i = 0; i < N; ++i) {
+                sf::Vertex* quad = &quads[static_cast<std::size_t>(i) * 6];
+                const sf::Vector2f a = positions[i] - sf::Vector2f{ 20.f, 20.f }, c = positions[i] + sf::Vector2f{ 20.f, 20.f };
+                quad[0].position = a;
+                quad[1].position = { c.x, a.y };
+                quad[2].position = c;
+                quad[3].position = a;
+                quad[4].position = c;
+                quad[5].position = { a.x, c.y };
+                if (not animation::step(set, states[i], 1.f / 60.f)) continue;
+                ++changed;
+                const sf::IntRect& r = set.frame(states[i].frame).rect;
+                const sf::Vector2f t(r.position), u(r.position + r.size);
+                quad[0].texCoords = t;
+                quad[1].texCoords = { u.x, t.y };
+                quad[2].texCoords = u;
+                quad[3].texCoords = t;
+                quad[4].texCoords = u;
+                quad[5].texCoords = { t.x, u.y };
+            }
+        }
+    });
+    bench::keep(changed);
+    bench::report("batch: move + update 50k quads", batched * 1e3 / Frames, "ms");
+    bench::report("per instance: move + step 50k quads", single * 1e3 / Frames, "ms");
+#ifdef NDEBUG
+    // the budget for 50k animated sprites
+    CHECK(batched / Frames < 1e-3);
+#endif
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Benchmarks and checks of the game's systems, without a window.
+// BENCH("name") { ... } registers a case; the runner executes every case whose name contains
+// the first command line argument (all of them without one). Cases report(...) their
+// measurements and CHECK(...) what has to hold; a failed check makes the run exit with 1.
+// Numbers are only meaningful from the Release build.
+namespace bench {
+    struct Case {
+        const char* name;
+        void (*run)();
+    };
+    std::vector<Case>& cases();
+
+    struct Register {
+        Register(const char* name, void (*run)()) { cases().push_back({ name, run }); }
+    };
+
+    void fail(const char* file, int line, const char* expression);
+    // one line per measurement: label, value, unit
+    void report(const char* label, double value, const char* unit);
+
+    // fastest of `repeats` runs of fn, in seconds
+    template <class Fn>
+    double seconds(Fn&& fn, int repeats = 5) {
+        double best = 1e30;
+        for (int r = 0; r < repeats; ++r) {
+            const auto start = std::chrono::steady_clock::now();
+            fn();
+            const std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+            if (took.count() < best) best = took.count();
+        }
+        return best;
+    }
+
+    // keeps the optimizer from dropping work whose result is otherwise unused
+    inline volatile double sink = 0.0;
+    template <class T>
+    void keep(const T& value) { sink = sink + static_cast<double>(value); }
+
+    // small deterministic generator, so runs compare
+    struct Random {
+        std::uint64_t state = 0x9E3779B97F4A7C15ull;
+        std::uint32_t next() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return static_cast<std::uint32_t>(state >> 16);
+        }
+        // [0, 1)
+        float unit() { return (next() & 0xFFFFFF) / 16777216.f; }
+        float range(float lo, float hi) { return lo + (hi - lo) * unit(); }
+    };
+}
+
+#define BENCH_JOIN2(a, b) a##b
+#define BENCH_JOIN(a, b) BENCH_JOIN2(a, b)
+#define BENCH(name)                                                                            \
+    static void BENCH_JOIN(benchCase, __LINE__)();                                             \
+    static const bench::Register BENCH_JOIN(benchRegister, __LINE__)(name, &BENCH_JOIN(benchCase, __LINE__)); \
+    static void BENCH_JOIN(benchCase, __LINE__)()
+#define CHECK(expression) ((expression) ? (void)0 : bench::fail(__FILE__, __LINE__, #expression))
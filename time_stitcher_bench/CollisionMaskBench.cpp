@@ -0,0 +1,83 @@
+#include "Bench.h"
+#include "CollisionMask.h"
+
+namespace {
+    // a disc filling a size x size texel image
+    sf::Image disc(unsigned size) {
+        sf::Image image({ size, size }, sf::Color::Transparent);
+        const float r = size * 0.5f;
+        for (unsigned y = 0; y < size; ++y)
+            for (unsigned x = 0; x < size; ++x) {
+                const float dx = x + 0.5f - r, dy = y + 0.5f - r;
+                if (dx * dx + dy * dy <= r * r) image.setPixel({ x, y }, sf::Color::White);
+            }
+        return image;
+    }
+
+    // the same question asked one pixel at a time
+    bool overlapsPerPixel(const CollisionMask& a, sf::Vector2i at, const CollisionMask& b, sf::Vector2i bt) {
+        for (int y = 0; y < a.height(); ++y)
+            for (int x = 0; x < a.width(); ++x)
+                if (a.test(x, y) and b.test(x + at.x - bt.x, y + at.y - bt.y)) return true;
+        return false;
+    }
+}
+
+// Two 96 x 96 world pixel discs (48 texels at scale 2) placed so their boxes overlap: the row
+// shifted ANDs against testing every pixel of one mask against the other. The placements that
+// meet only in the corners of the boxes are the ones the narrow phase has to answer no for.
+BENCH("collision mask: disc against disc") {
+    constexpr int Pairs = 20000;
+    const sf::Image image = disc(48);
+    const CollisionMask a = CollisionMask::fromImage(image, sf::IntRect({ 0, 0 }, { 48, 48 }), 2.f);
+    const CollisionMask b = CollisionMask::fromImage(image, sf::IntRect({ 0, 0 }, { 48, 48 }), 2.f);
+    CHECK(a.width() == 96 and a.height() == 96);
+    CHECK(a.test(48, 48) and not a.test(0, 0));
+
+    bench::Random random;
+    std::vector<sf::Vector2i> offsets(Pairs);
+    for (sf::Vector2i& offset : offsets)
+        offset = { static_cast<int>(random.next() % 191) - 95, static_cast<int>(random.next() % 191) - 95 };
+
+    std::size_t hits = 0, agree = 0;
+    for (const sf::Vector2i& offset : offsets) {
+        const bool fast = collision::overlaps(a, { 0, 0 }, b, offset);
+        hits += fast;
+        agree += fast == overlapsPerPixel(a, { 0, 0 }, b, offset);
+    }
+    CHECK(agree == offsets.size());
+    CHECK(hits > 0 and hits < offsets.size());
+
+    std::size_t count = 0;
+    const double masked = bench::seconds([&] {
+        for (const sf::Vector2i& offset : offsets) count += collision::overlaps(a, { 0, 0 }, b, offset);
+    });
+    const double perPixel = bench::seconds([&] {
+        for (const sf::Vector2i& offset : offsets) count += overlapsPerPixel(a, { 0, 0 }, b, offset);
+    });
+    bench::keep(count);
+    bench::report("placements that touch", 100.0 * hits / Pairs, "%");
+    bench::report("bit masks: per pair", masked * 1e9 / Pairs, "ns");
+    bench::report("per pixel: per pair", perPixel * 1e9 / Pairs, "ns");
+}
+
+// A disc against wall tiles around it, the player against the maze.
+BENCH("collision mask: disc against solid rectangles") {
+    const sf::Image image = disc(48);
+    const CollisionMask a = CollisionMask::fromImage(image, sf::IntRect({ 0, 0 }, { 48, 48 }), 2.f);
+    CHECK(not collision::overlaps(a, { 0, 0 }, sf::IntRect({ 0, 0 }, { 8, 8 })));
+    CHECK(collision::overlaps(a, { 0, 0 }, sf::IntRect({ 40, 0 }, { 16, 8 })));
+    CHECK(not collision::overlaps(a, { 0, 0 }, sf::IntRect({ 96, 0 }, { 32, 32 })));
+
+    constexpr int Tests = 20000;
+    bench::Random random;
+    std::vector<sf::IntRect> walls(Tests);
+    for (sf::IntRect& wall : walls)
+        wall = sf::IntRect({ static_cast<int>(random.next() % 160) - 64, static_cast<int>(random.next() % 160) - 64 }, { 32, 32 });
+    std::size_t count = 0;
+    const double took = bench::seconds([&] {
+        for (const sf::IntRect& wall : walls) count += collision::overlaps(a, { 0, 0 }, wall);
+    });
+    bench::keep(count);
+    bench::report("mask against 32 x 32 wall", took * 1e9 / Tests, "ns");
+}
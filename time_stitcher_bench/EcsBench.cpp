@@ -0,0 +1,78 @@
+#include "Bench.h"
+#include "Components.h"
+#include "Ecs.h"
+#include <memory>
+
+namespace {
+    // what the registry replaced: one heap object per entity, updated through a virtual call
+    struct Mover {
+        virtual ~Mover() = default;
+        virtual void update(float dt) = 0;
+    };
+    struct Walker final : Mover {
+        sf::Vector2f position, velocity;
+        void update(float dt) override { position += velocity * dt; }
+    };
+}
+
+BENCH("ecs: iteration and churn") {
+    constexpr int N = 100000;
+    bench::Random random;
+
+    Registry registry;
+    registry.reserve<Position, Velocity, Chaser>(N);
+    std::vector<std::unique_ptr<Mover>> objects;
+    for (int i = 0; i < N; ++i) {
+        const sf::Vector2f p{ random.range(0.f, 1000.f), random.range(0.f, 1000.f) };
+        const sf::Vector2f v{ random.range(-50.f, 50.f), random.range(-50.f, 50.f) };
+        Entity e = registry.create();
+        registry.emplace<Position>(e, p);
+        registry.emplace<Velocity>(e, v);
+        if (i % 2 == 0) registry.emplace<Chaser>(e);
+        auto walker = std::make_unique<Walker>();
+        walker->position = p;
+        walker->velocity = v;
+        objects.push_back(std::move(walker));
+    }
+
+    int visited = 0;
+    const double each = bench::seconds([&] {
+        visited = 0;
+        registry.each<Position, Velocity>([&](Entity, Position& pos, Velocity& vel) {
+            pos.value += vel.value * (1.f / 60.f);
+            ++visited;
+        });
+    });
+    CHECK(visited == N);
+    bench::report("each<Position, Velocity>, 100k", each * 1e3, "ms");
+
+    int chasers = 0;
+    const double sparse = bench::seconds([&] {
+        chasers = 0;
+        registry.each<Chaser, Position>([&](Entity, Chaser& chaser, Position& pos) {
+            pos.value.x += chaser.speed * (1.f / 60.f);
+            ++chasers;
+        });
+    });
+    CHECK(chasers == N / 2);
+    bench::report("each<Chaser, Position>, 50k of 100k", sparse * 1e3, "ms");
+
+    const double virtuals = bench::seconds([&] {
+        for (auto& object : objects) object->update(1.f / 60.f);
+    });
+    bench::report("virtual update of 100k heap objects", virtuals * 1e3, "ms");
+
+    // destroy and re-create a tenth of the entities, as a burst of despawns and spawns would
+    std::vector<Entity> entities(registry.pool<Position>().entities());
+    const double churn = bench::seconds([&] {
+        for (int i = 0; i < N / 10; ++i) {
+            Entity& e = entities[random.next() % entities.size()];
+            registry.destroy(e);
+            e = registry.create();
+            registry.emplace<Position>(e);
+            registry.emplace<Velocity>(e);
+        }
+    });
+    CHECK(registry.alive() == static_cast<std::size_t>(N));
+    bench::report("destroy + create with 2 components, per entity", churn * 1e9 / (N / 10), "ns");
+}
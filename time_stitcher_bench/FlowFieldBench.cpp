@@ -0,0 +1,46 @@
+#include "Bench.h"
+#include "FlowField.h"
+#include "Maze.h"
+
+// Recomputes towards a moving target on a 512² maze (513² once rounded to odd sizes, walls on
+// the border), 10k agents looking up their direction, and the publish timing the deterministic
+// simulation relies on. The field is grown up to the default 512 BFS steps from the target.
+BENCH("flow field: recompute and sample") {
+    const Maze maze(7, 512, 512);
+    const TileGrid grid = TileGrid::fromMaze(maze);
+    JobSystem jobs(1);
+    FlowField field(jobs);
+    field.reset(grid);
+    bench::Random random;
+    auto cell = [&] { return maze.nearestCell({ static_cast<int>(random.next() % maze.width()), static_cast<int>(random.next() % maze.height()) }); };
+
+    constexpr int Targets = 32;
+    bool onTime = true;
+    const double s = bench::seconds([&] {
+        for (int i = 0; i < Targets; ++i) {
+            const sf::Vector2i target = cell();
+            for (int u = 0; u <= FlowField::PublishDelay; ++u) {
+                field.update(target);
+                // published exactly PublishDelay updates after the request, never earlier
+                if ((field.target() == target) != (u == FlowField::PublishDelay)) onTime = false;
+            }
+        }
+    }, 3);
+    bench::report("recompute, from request to publish", s * 1e3 / Targets, "ms");
+    CHECK(onTime);
+
+    std::vector<sf::Vector2i> agents;
+    for (int i = 0; i < 10000; ++i) {
+        const sf::Vector2i t = field.target();
+        agents.push_back({ t.x + static_cast<int>(random.next() % 200) - 100, t.y + static_cast<int>(random.next() % 200) - 100 });
+    }
+    float sum = 0.f;
+    const double sample = bench::seconds([&] {
+        for (const sf::Vector2i& tile : agents) {
+            const sf::Vector2f d = field.direction(tile);
+            sum += d.x + d.y;
+        }
+    });
+    bench::keep(sum);
+    bench::report("10k agents looking up their direction", sample * 1e6, "us");
+}
@@ -0,0 +1,58 @@
+#include "Bench.h"
+#include "FogOfWar.h"
+#include "Maze.h"
+#include <cstdio>
+
+namespace {
+    // a recompute per step of a walk over floor tiles, which is what the game does
+    void measure(const char* what, const TileGrid& grid, int radius) {
+        FogOfWar fog(radius);
+        fog.reset(grid, 16.f);
+        bench::Random random;
+        std::vector<sf::Vector2i> origins;
+        while (origins.size() < 2000) {
+            const sf::Vector2i t(static_cast<int>(random.next() % grid.width()), static_cast<int>(random.next() % grid.height()));
+            if (grid.walkable(t)) origins.push_back(t);
+        }
+        const double took = bench::seconds([&] {
+            for (const sf::Vector2i& origin : origins) fog.update(origin);
+        });
+
+        // symmetric: a floor tile the origin sees sees the origin back
+        std::size_t pairs = 0, symmetric = 0;
+        for (int i = 0; i < 20; ++i) {
+            const sf::Vector2i a = origins[i];
+            fog.update(a);
+            std::vector<sf::Vector2i> seen;
+            for (int y = a.y - radius; y <= a.y + radius; ++y)
+                for (int x = a.x - radius; x <= a.x + radius; ++x)
+                    if (fog.visible(x, y) and grid.walkable(x, y) and (x * 7 + y * 13) % 5 == 0) seen.push_back({ x, y });
+            for (const sf::Vector2i& b : seen) {
+                fog.update(b);
+                ++pairs;
+                symmetric += fog.visible(a.x, a.y);
+            }
+        }
+        CHECK(pairs > 0 and symmetric == pairs);
+
+        char label[96];
+        std::snprintf(label, sizeof label, "%s, radius %d: recompute", what, radius);
+        bench::report(label, took * 1e6 / origins.size(), "us");
+    }
+}
+
+// Radius 10 (the game's) and 64, on the game's maze and on an open 1024² grid with 10%
+// scattered walls, where far more of the disc is lit.
+BENCH("fog of war: recompute") {
+    const Maze maze(7);
+    const TileGrid mazeGrid = TileGrid::fromMaze(maze);
+    TileGrid open(1024, 1024);
+    bench::Random random;
+    for (int y = 0; y < open.height(); ++y)
+        for (int x = 0; x < open.width(); ++x)
+            if (random.next() % 10 == 0) open.set(x, y, true);
+    for (int radius : { 10, 64 }) {
+        measure("maze 1023^2", mazeGrid, radius);
+        measure("10% walls", open, radius);
+    }
+}
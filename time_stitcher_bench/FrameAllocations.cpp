@@ -0,0 +1,55 @@
+#include "Bench.h"
+#include "MemoryTracker.h"
+#include "Systems.h"
+
+// Echoes are the entities spawned while playing. Spawned past a cap, the oldest is despawned, the
+// way Game::spawnEcho does it; boxes jitter so mover pairs keep starting and stopping. Once the
+// pools are warm, a frame of that must not touch the heap.
+BENCH("frame allocations: echo spawn and despawn") {
+    constexpr std::size_t MaxEchoes = 256;
+    constexpr int WarmUpFrames = 120;
+    constexpr int Frames = 600;
+
+    sf::Texture texture; // only referenced by the frames, never drawn
+    AnimationSet set;
+    for (int i = 0; i < 8; ++i) set.addFrame(texture, sf::IntRect({ i * 32, 0 }, { 32, 32 }));
+    set.addClip(0, 4, 0.1f);
+    set.addClip(4, 4, 0.1f);
+
+    Registry registry;
+    SweepAndPrune movers;
+    AnimationBatch batch;
+    batch.setAnimations(&set);
+    registry.reserve<Position, Velocity, Collider, Chaser, Animated, SweepProxy>(1024);
+    movers.reserve(1024);
+    batch.reserve(1024);
+    std::vector<Entity> ring(MaxEchoes, NullEntity);
+    std::size_t next = 0;
+    bench::Random random;
+
+    std::uint64_t worst = 0;
+    for (int frame = 0; frame < WarmUpFrames + Frames; ++frame) {
+        for (int i = 0; i < 8; ++i) {
+            Entity& slot = ring[next];
+            next = (next + 1) % ring.size();
+            systems::despawnEcho(registry, movers, batch, slot);
+            slot = systems::spawnEcho(registry, movers, batch, { random.range(0.f, 800.f), random.range(0.f, 800.f) },
+                                      random.next() % 2, sf::Color::White);
+        }
+        registry.each<Position, Animated>([&](Entity, Position& pos, Animated& anim) {
+            pos.value += { random.range(-4.f, 4.f), random.range(-4.f, 4.f) };
+            batch.setPosition(anim.slot, pos.value);
+        });
+        systems::collideMovers(registry, movers);
+        batch.update(1.f / 60.f);
+        registry.flush();
+
+        memory::endFrame();
+        if (frame >= WarmUpFrames) worst = std::max(worst, memory::frameAllocations());
+    }
+    bench::report("allocations in the worst frame after warm-up", static_cast<double>(worst), "");
+    bench::report("live echoes", static_cast<double>(registry.pool<Chaser>().size()), "");
+    CHECK(worst == 0);
+    CHECK(registry.pool<Chaser>().size() == MaxEchoes);
+    CHECK(batch.size() == MaxEchoes);
+}
@@ -0,0 +1,48 @@
+#include "Bench.h"
+#include "Ecs.h"
+#include "FrameArena.h"
+#include "MemoryTracker.h"
+
+namespace {
+    // a frame's worth of scratch lists, like the contact and candidate lists of the systems
+    std::size_t scratchFrame(std::pmr::memory_resource* memory, bench::Random& random) {
+        std::size_t total = 0;
+        for (int list = 0; list < 2000; ++list) {
+            std::pmr::vector<Entity> hits(memory);
+            const std::uint32_t n = random.next() % 48;
+            for (std::uint32_t i = 0; i < n; ++i) hits.push_back(i);
+            total += hits.size();
+        }
+        return total;
+    }
+}
+
+BENCH("frame arena: scratch lists against the heap") {
+    constexpr int Frames = 50;
+    FrameArena arena;
+    bench::Random random;
+
+    // first frames size the buffer to the high-water mark
+    for (int i = 0; i < 3; ++i) {
+        bench::keep(scratchFrame(&arena, random));
+        arena.reset();
+    }
+    const std::size_t overflows = arena.overflows();
+    const std::uint64_t allocations = memory::allocations();
+    const double pooled = bench::seconds([&] {
+        for (int f = 0; f < Frames; ++f) {
+            bench::keep(scratchFrame(&arena, random));
+            arena.reset();
+        }
+    });
+    const std::uint64_t arenaAllocations = memory::allocations() - allocations;
+    const double heap = bench::seconds([&] {
+        for (int f = 0; f < Frames; ++f) bench::keep(scratchFrame(std::pmr::new_delete_resource(), random));
+    });
+
+    bench::report("frame of 2000 scratch lists, arena", pooled * 1e3 / Frames, "ms");
+    bench::report("frame of 2000 scratch lists, new/delete", heap * 1e3 / Frames, "ms");
+    bench::report("arena high-water", static_cast<double>(arena.highWater()) / 1024.0, "KiB");
+    CHECK(arena.overflows() == overflows);
+    CHECK(arenaAllocations == 0);
+}
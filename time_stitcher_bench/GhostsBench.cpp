@@ -0,0 +1,60 @@
+#include "Bench.h"
+#include "Ghosts.h"
+#include "Obstacle.h"
+
+// 1000 ghosts replaying 64 one-minute runs through a 4000 x 4000 area with 300 obstacles in the
+// tree, as Game::update drives them. Ghosts that walk into an obstacle touch it and wait.
+BENCH("ghosts: 1000 against the obstacle tree") {
+    constexpr int Ghosts = 1000;
+    constexpr int Frames = 600;
+    bench::Random random;
+
+    Registry registry;
+    AabbTree tree;
+    for (int i = 0; i < 300; ++i) {
+        const Entity e = registry.create();
+        const Obstacle& obs = registry.emplace<Obstacle>(e, sf::Vector2f(random.range(0.f, 4000.f), random.range(0.f, 4000.f)));
+        tree.insert(obs.getBounds(), e);
+    }
+
+    ::Ghosts ghosts;
+    ghosts.reserve(Ghosts);
+    for (int t = 0; t < 64; ++t) {
+        GhostRecorder recorder;
+        sf::Vector2f p{ random.range(0.f, 4000.f), random.range(0.f, 4000.f) };
+        sf::Vector2f heading{ 150.f, 0.f };
+        recorder.start(p);
+        for (int tick = 0; tick < 60 * 30; ++tick) {
+            if (tick % 30 == 0) heading = { random.range(-150.f, 150.f), random.range(-150.f, 150.f) };
+            p += heading * GhostTrack::TickTime;
+            recorder.record(p, GhostTrack::TickTime);
+        }
+        ghosts.addTrack(recorder.finish());
+    }
+    for (int g = 0; g < Ghosts; ++g) ghosts.spawn(static_cast<std::uint32_t>(g % 64));
+    CHECK(ghosts.size() == static_cast<std::size_t>(Ghosts));
+
+    const Player look(""); // no animations set: only needed for the clip choice
+    double total = 0.0, worst = 0.0;
+    std::size_t touched = 0;
+    for (int frame = 0; frame < Frames; ++frame) {
+        const auto start = std::chrono::steady_clock::now();
+        ghosts.update(registry, tree, look, 1.f / 60.f);
+        const std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+        total += took.count();
+        worst = std::max(worst, took.count());
+        registry.each<Obstacle>([&](Entity, Obstacle& obs) {
+            touched += obs.m_didTouch;
+            obs.m_didTouch = false;
+        });
+    }
+    CHECK(touched > 0);
+
+    bench::report("update, mean", total * 1e3 / Frames, "ms");
+    bench::report("update, worst", worst * 1e3, "ms");
+    bench::report("obstacle touches per second", touched / (Frames / 60.0), "");
+#ifdef NDEBUG
+    // a small share of the 16.7 ms frame
+    CHECK(total / Frames < 1e-3);
+#endif
+}
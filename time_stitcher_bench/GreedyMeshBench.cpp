@@ -0,0 +1,71 @@
+#include "Bench.h"
+#include "ChunkWorld.h"
+#include "GreedyMesh.h"
+#include <array>
+#include <bit>
+
+// The game's 1023² maze cut into chunks as ChunkWorld builds them: merging each chunk's walls
+// into rectangles against one box per wall cell. The rectangles must cover exactly the wall
+// cells, each one once.
+BENCH("greedy mesh: maze 1023^2 walls") {
+    constexpr int Tiles = Chunk::Tiles;
+    const Maze maze(7);
+    const int chunksX = (maze.width() + Tiles - 1) / Tiles, chunksY = (maze.height() + Tiles - 1) / Tiles;
+    std::vector<std::array<std::uint64_t, Tiles>> chunks(static_cast<std::size_t>(chunksX) * chunksY);
+    std::size_t cells = 0;
+    for (int cy = 0; cy < chunksY; ++cy)
+        for (int cx = 0; cx < chunksX; ++cx) {
+            auto& rows = chunks[static_cast<std::size_t>(cy) * chunksX + cx];
+            for (int y = 0; y < Tiles; ++y) {
+                rows[y] = 0;
+                for (int x = 0; x < Tiles; ++x)
+                    if (maze.isWall(cx * Tiles + x, cy * Tiles + y)) rows[y] |= std::uint64_t{ 1 } << x;
+                cells += static_cast<std::size_t>(std::popcount(rows[y]));
+            }
+        }
+
+    std::vector<sf::IntRect> rects;
+    rects.reserve(cells);
+    const double merged = bench::seconds([&] {
+        rects.clear();
+        for (std::size_t c = 0; c < chunks.size(); ++c) {
+            std::array<std::uint64_t, Tiles> merge = chunks[c]; // consumed
+            const sf::Vector2i origin(static_cast<int>(c % chunksX) * Tiles, static_cast<int>(c / chunksX) * Tiles);
+            meshing::greedyRects(merge, rects, origin);
+        }
+    });
+    std::vector<sf::IntRect> boxes;
+    boxes.reserve(cells);
+    const double perCell = bench::seconds([&] {
+        boxes.clear();
+        for (std::size_t c = 0; c < chunks.size(); ++c) {
+            const sf::Vector2i origin(static_cast<int>(c % chunksX) * Tiles, static_cast<int>(c / chunksX) * Tiles);
+            for (int y = 0; y < Tiles; ++y)
+                for (std::uint64_t bits = chunks[c][y]; bits != 0; bits &= bits - 1)
+                    boxes.push_back({ { origin.x + std::countr_zero(bits), origin.y + y }, { 1, 1 } });
+        }
+    });
+    CHECK(boxes.size() == cells);
+
+    // every wall cell covered once, nothing else covered
+    std::vector<std::uint8_t> covered(static_cast<std::size_t>(chunksX) * Tiles * chunksY * Tiles, 0);
+    const int stride = chunksX * Tiles;
+    bool once = true;
+    for (const sf::IntRect& r : rects)
+        for (int y = r.position.y; y < r.position.y + r.size.y; ++y)
+            for (int x = r.position.x; x < r.position.x + r.size.x; ++x)
+                if (++covered[static_cast<std::size_t>(y) * stride + x] != 1) once = false;
+    bool exact = true;
+    for (int y = 0; y < chunksY * Tiles; ++y)
+        for (int x = 0; x < stride; ++x)
+            if ((covered[static_cast<std::size_t>(y) * stride + x] != 0) != maze.isWall(x, y)) exact = false;
+    CHECK(once);
+    CHECK(exact);
+
+    bench::report("chunks", static_cast<double>(chunks.size()), "");
+    bench::report("wall cells", static_cast<double>(cells), "");
+    bench::report("merged rectangles", static_cast<double>(rects.size()), "");
+    bench::report("fewer quads and boxes", static_cast<double>(cells) / rects.size(), "x");
+    bench::report("greedy rectangles, per chunk", merged * 1e6 / chunks.size(), "us");
+    bench::report("one box per cell, per chunk", perCell * 1e6 / chunks.size(), "us");
+}
@@ -0,0 +1,58 @@
+#include "Bench.h"
+#include "Particles.h"
+#include <cstdio>
+
+namespace {
+    // 100k particles kept alive: every frame bursts refill what died, then update and mesh.
+    // Lives of 0.3..0.8 s mean about 3000 die and respawn each frame, so compaction runs too.
+    void measure(const char* what, JobSystem* jobs) {
+        constexpr std::size_t Capacity = 100000;
+        constexpr int WarmUpFrames = 60;
+        constexpr int Frames = 300;
+        ParticleSystem particles(Capacity);
+        particles.setJobs(jobs);
+        sf::RenderTexture target({ 64, 64 }); // the draw call itself isn't what's measured
+        ParticleEffect effect;
+        effect.count = 1000;
+        bench::Random random;
+
+        double update = 0.0, draw = 0.0, worst = 0.0;
+        std::size_t fewest = Capacity;
+        for (int frame = 0; frame < WarmUpFrames + Frames; ++frame) {
+            while (particles.size() + effect.count <= Capacity)
+                particles.burst({ random.range(0.f, 4000.f), random.range(0.f, 4000.f) }, effect);
+            const auto start = std::chrono::steady_clock::now();
+            particles.update(1.f / 60.f);
+            const auto updated = std::chrono::steady_clock::now();
+            particles.draw(target);
+            const auto drawn = std::chrono::steady_clock::now();
+            if (frame < WarmUpFrames) continue;
+            const std::chrono::duration<double> u = updated - start, d = drawn - updated;
+            update += u.count();
+            draw += d.count();
+            worst = std::max(worst, u.count() + d.count());
+            fewest = std::min(fewest, particles.size());
+        }
+        CHECK(fewest > Capacity * 9 / 10);
+
+        char label[96];
+        std::snprintf(label, sizeof label, "%s: update", what);
+        bench::report(label, update * 1e3 / Frames, "ms");
+        std::snprintf(label, sizeof label, "%s: mesh + draw", what);
+        bench::report(label, draw * 1e3 / Frames, "ms");
+        std::snprintf(label, sizeof label, "%s: worst frame", what);
+        bench::report(label, worst * 1e3, "ms");
+#ifdef NDEBUG
+        // the budget for 100k particles
+        CHECK((update + draw) / Frames < 2e-3);
+#endif
+    }
+}
+
+BENCH("particles: 100k alive") {
+    measure("one thread", nullptr);
+    JobSystem jobs;
+    char what[64];
+    std::snprintf(what, sizeof what, "%u workers + caller", jobs.workerCount());
+    measure(what, &jobs);
+}
@@ -0,0 +1,72 @@
+#include "Bench.h"
+#include "Maze.h"
+#include "Pathfinder.h"
+#include <cmath>
+#include <cstdio>
+
+namespace {
+    float pathCost(const std::vector<sf::Vector2i>& path) {
+        float cost = 0.f;
+        for (std::size_t i = 1; i < path.size(); ++i)
+            cost += (path[i].x != path[i - 1].x and path[i].y != path[i - 1].y) ? 1.41421356f : 1.f;
+        return cost;
+    }
+
+    // same queries in both modes: time per query, expanded nodes, and A*'s path cost as the reference
+    void compare(const char* what, const TileGrid& grid, const std::vector<std::pair<sf::Vector2i, sf::Vector2i>>& queries) {
+        Pathfinder pathfinder(grid);
+        std::vector<sf::Vector2i> path;
+        std::vector<float> costs;
+        for (const auto& [start, goal] : queries)
+            costs.push_back(pathfinder.findPath(start, goal, path, Pathfinder::Mode::AStar) ? pathCost(path) : -1.f);
+        for (Pathfinder::Mode mode : { Pathfinder::Mode::AStar, Pathfinder::Mode::JumpPoint }) {
+            const char* name = mode == Pathfinder::Mode::AStar ? "A*" : "JPS";
+            std::size_t expanded = 0;
+            const double s = bench::seconds([&] {
+                expanded = 0;
+                for (const auto& [start, goal] : queries) {
+                    pathfinder.findPath(start, goal, path, mode);
+                    expanded += pathfinder.lastExpanded();
+                }
+            }, 3);
+            char label[96];
+            std::snprintf(label, sizeof label, "%s %s: per query", what, name);
+            bench::report(label, s * 1e3 / queries.size(), "ms");
+            std::snprintf(label, sizeof label, "%s %s: expanded per query", what, name);
+            bench::report(label, static_cast<double>(expanded) / queries.size(), "nodes");
+        }
+        for (std::size_t i = 0; i < queries.size(); ++i) {
+            const bool found = pathfinder.findPath(queries[i].first, queries[i].second, path, Pathfinder::Mode::JumpPoint);
+            CHECK(found == (costs[i] >= 0.f));
+            if (found) CHECK(std::abs(pathCost(path) - costs[i]) < 1e-2f);
+        }
+    }
+}
+
+// The game's 1023² maze and an open grid of the same size with 10% scattered walls.
+BENCH("pathfinding: A* vs jump point search") {
+    bench::Random random;
+    {
+        const Maze maze(7);
+        const TileGrid grid = TileGrid::fromMaze(maze);
+        std::vector<std::pair<sf::Vector2i, sf::Vector2i>> queries;
+        for (int i = 0; i < 32; ++i) {
+            auto cell = [&] { return maze.nearestCell({ static_cast<int>(random.next() % maze.width()), static_cast<int>(random.next() % maze.height()) }); };
+            queries.push_back({ cell(), cell() });
+        }
+        compare("maze 1023^2", grid, queries);
+    }
+    {
+        TileGrid grid(1024, 1024);
+        for (int i = 0; i < 1024 * 1024 / 10; ++i) grid.set(random.next() % 1024, random.next() % 1024, true);
+        std::vector<std::pair<sf::Vector2i, sf::Vector2i>> queries;
+        auto free = [&] {
+            for (;;) {
+                sf::Vector2i t{ static_cast<int>(random.next() % 1024), static_cast<int>(random.next() % 1024) };
+                if (not grid.blocked(t.x, t.y)) return t;
+            }
+        };
+        for (int i = 0; i < 32; ++i) queries.push_back({ free(), free() });
+        compare("open 1024^2, 10% walls", grid, queries);
+    }
+}
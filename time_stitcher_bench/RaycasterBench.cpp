@@ -0,0 +1,109 @@
+#include "Bench.h"
+#include "Maze.h"
+#include "Raycaster.h"
+#include <cmath>
+#include <cstdio>
+
+namespace {
+    constexpr float TileSize = 16.f;
+
+    sf::Vector2f floorPoint(const TileGrid& grid, bench::Random& random) {
+        for (;;) {
+            const sf::Vector2f p(random.range(0.f, grid.width() * TileSize), random.range(0.f, grid.height() * TileSize));
+            if (grid.walkable(static_cast<int>(p.x / TileSize), static_cast<int>(p.y / TileSize))) return p;
+        }
+    }
+
+    // reference: sample the segment in small steps up to the hit (or the end)
+    bool clearUpTo(const TileGrid& grid, const Ray& ray, float fraction) {
+        const sf::Vector2f d = ray.to - ray.from;
+        const float length = std::hypot(d.x, d.y);
+        // stop a hundredth of a pixel short of the hit point, which lies on the wall's border
+        const float end = fraction - 0.01f / length;
+        const int steps = static_cast<int>(length / TileSize * 20.f) + 1;
+        for (int i = 0; i < steps and end > 0.f; ++i) {
+            const float t = end * i / steps;
+            const sf::Vector2f p = ray.from + d * t;
+            if (grid.blocked(static_cast<int>(std::floor(p.x / TileSize)), static_cast<int>(std::floor(p.y / TileSize)))) return false;
+        }
+        return true;
+    }
+
+    void measure(const char* what, const TileGrid& grid, const Raycaster& raycaster, float length) {
+        constexpr int N = 100000;
+        bench::Random random;
+        std::vector<Ray> rays(N);
+        for (Ray& ray : rays) {
+            ray.from = floorPoint(grid, random);
+            const float angle = random.range(0.f, 6.2831853f);
+            ray.to = ray.from + sf::Vector2f(std::cos(angle), std::sin(angle)) * length;
+        }
+        std::vector<RayHit> hits(N);
+        const double took = bench::seconds([&] { raycaster.cast(rays, hits); });
+
+        std::size_t blocked = 0, agree = 0;
+        for (int i = 0; i < 2000; ++i) {
+            const RayHit& hit = hits[i];
+            blocked += hit.hit;
+            agree += hit.hit ? grid.blocked(hit.tile.x, hit.tile.y) and clearUpTo(grid, rays[i], hit.fraction)
+                             : clearUpTo(grid, rays[i], 1.f);
+        }
+        CHECK(agree == 2000);
+
+        char label[96];
+        std::snprintf(label, sizeof label, "%s: rays per second", what);
+        bench::report(label, N / took / 1e6, "M");
+        std::snprintf(label, sizeof label, "%s: rays blocked", what);
+        bench::report(label, 100.0 * blocked / 2000, "%");
+    }
+}
+
+// 100k rays of 64 tiles from random floor points: on the game's maze, on an empty 1024² grid,
+// on one with 10% scattered walls, and on that one again with 5000 obstacles in the tree. Every
+// hit of a sample is checked against stepping along the ray in 1/20 tile steps.
+BENCH("raycaster: 1024^2 grids") {
+    const float length = 64.f * TileSize;
+    {
+        const Maze maze(7);
+        const TileGrid grid = TileGrid::fromMaze(maze);
+        const Raycaster raycaster(grid, TileSize);
+        measure("maze 1023^2", grid, raycaster, length);
+    }
+    TileGrid grid(1024, 1024);
+    {
+        // nothing to hit: every ray walks all of its ~90 tiles
+        const Raycaster raycaster(grid, TileSize);
+        measure("no walls", grid, raycaster, length);
+    }
+    bench::Random random;
+    for (int y = 0; y < grid.height(); ++y)
+        for (int x = 0; x < grid.width(); ++x)
+            if (random.next() % 10 == 0) grid.set(x, y, true);
+    Raycaster raycaster(grid, TileSize);
+    measure("10% walls", grid, raycaster, length);
+
+    AabbTree tree;
+    std::vector<sf::FloatRect> boxes(5000);
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        boxes[i] = { { random.range(0.f, 1024.f * TileSize), random.range(0.f, 1024.f * TileSize) }, { 12.f, 12.f } };
+        tree.insert(boxes[i], static_cast<std::uint32_t>(i));
+    }
+    raycaster.setObstacles(&tree, [&](std::uint32_t data, sf::FloatRect& box) {
+        box = boxes[data];
+        return true;
+    });
+    constexpr int N = 100000;
+    std::vector<Ray> rays(N);
+    for (Ray& ray : rays) {
+        ray.from = floorPoint(grid, random);
+        const float angle = random.range(0.f, 6.2831853f);
+        ray.to = ray.from + sf::Vector2f(std::cos(angle), std::sin(angle)) * length;
+    }
+    std::vector<RayHit> hits(N);
+    const double took = bench::seconds([&] { raycaster.cast(rays, hits); });
+    std::size_t byObstacle = 0;
+    for (const RayHit& hit : hits) byObstacle += hit.obstacle != RayHit::NoObstacle;
+    CHECK(byObstacle > 0);
+    bench::report("10% walls + 5000 obstacles: rays per second", N / took / 1e6, "M");
+    bench::report("10% walls + 5000 obstacles: stopped by an obstacle", 100.0 * byObstacle / N, "%");
+}
@@ -0,0 +1,85 @@
+#include "Bench.h"
+#include "Ghosts.h"
+#include "Snapshot.h"
+#include <cstdio>
+#include <cstring>
+
+// A large quicksave: 100k obstacles, 1k chasers, 16 ghosts on 5-minute runs and an hour of tick
+// hashes, written and loaded through a temporary file. Also checks that a ghost section whose
+// tick count doesn't match its bytes is refused.
+BENCH("snapshot: save and load") {
+    bench::Random random;
+    using namespace snapshot;
+
+    std::vector<ObstacleRecord> obstacles(100000);
+    for (auto& o : obstacles) o = { random.range(0.f, 4000.f), random.range(0.f, 4000.f), 0, -1, 1, 0, {} };
+    std::vector<ChaserRecord> chasers(1000);
+    for (auto& c : chasers) c = { random.range(0.f, 4000.f), random.range(0.f, 4000.f), 1.f, 0.f, 120.f };
+    std::vector<std::uint64_t> hashes(60 * 60 * 60);
+    for (auto& h : hashes) h = random.next();
+
+    Ghosts ghosts;
+    for (int g = 0; g < 16; ++g) {
+        GhostRecorder recorder;
+        sf::Vector2f p{ random.range(0.f, 4000.f), random.range(0.f, 4000.f) };
+        recorder.start(p);
+        for (int t = 0; t < 5 * 60 * 30; ++t) {
+            p += { random.range(-5.f, 5.f), random.range(-5.f, 5.f) };
+            recorder.record(p, GhostTrack::TickTime);
+        }
+        ghosts.spawn(ghosts.addTrack(recorder.finish()));
+    }
+
+    const std::string path = "bench_snapshot.tss";
+    const double save = bench::seconds([&] {
+        SnapshotWriter out;
+        out.add(Section::Obstacles, obstacles);
+        out.add(Section::Chasers, chasers);
+        ghosts.write(out);
+        out.add(Section::Hashes, hashes);
+        out.save(path);
+    });
+    Snapshot in;
+    bool loaded = false;
+    const double load = bench::seconds([&] { loaded = in.load(path); });
+
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    long bytes = 0;
+    if (file) {
+        std::fseek(file, 0, SEEK_END);
+        bytes = std::ftell(file);
+        std::fclose(file);
+    }
+    bench::report("save", save * 1e3, "ms");
+    bench::report("load", load * 1e3, "ms");
+    bench::report("file size", bytes / (1024.0 * 1024.0), "MiB");
+#ifdef NDEBUG
+    // checkpoints of a 100k obstacle world take a few milliseconds
+    CHECK(save < 5e-3);
+    CHECK(load < 5e-3);
+#endif
+
+    CHECK(loaded);
+    auto loadedObstacles = in.get<ObstacleRecord>(Section::Obstacles);
+    CHECK(loadedObstacles.size() == obstacles.size()
+          and std::memcmp(loadedObstacles.data(), obstacles.data(), obstacles.size() * sizeof(ObstacleRecord)) == 0);
+    CHECK(in.get<std::uint64_t>(Section::Hashes).size() == hashes.size());
+    CHECK(Ghosts::check(in));
+    Ghosts restored;
+    CHECK(restored.read(in) and restored.size() == ghosts.size());
+
+    // one tick more than the bytes hold: must be refused before anything is restored
+    std::vector<GhostTrackRecord> tracks(in.get<GhostTrackRecord>(Section::GhostTracks).begin(),
+                                         in.get<GhostTrackRecord>(Section::GhostTracks).end());
+    std::vector<std::uint8_t> trackBytes(in.get<std::uint8_t>(Section::GhostTrackBytes).begin(),
+                                         in.get<std::uint8_t>(Section::GhostTrackBytes).end());
+    ++tracks.back().ticks;
+    SnapshotWriter damaged;
+    damaged.add(Section::GhostTracks, tracks);
+    damaged.add(Section::GhostTrackBytes, trackBytes);
+    damaged.save(path);
+    Snapshot broken;
+    CHECK(broken.load(path));
+    CHECK(not Ghosts::check(broken));
+    std::remove(path.c_str());
+}
@@ -0,0 +1,59 @@
+#include "Bench.h"
+#include "SweepAndPrune.h"
+
+// 10k boxes of 8..24 px in a 4000 x 4000 world moving at up to 2 px a frame: the incremental
+// update against testing every pair, which is what it replaces. Both have to agree on the count.
+BENCH("sweep and prune: 10k moving boxes against all pairs") {
+    constexpr int N = 10000;
+    constexpr int Frames = 60;
+    bench::Random random;
+    std::vector<sf::FloatRect> boxes(N);
+    std::vector<sf::Vector2f> velocities(N);
+    for (int i = 0; i < N; ++i) {
+        const float size = random.range(8.f, 24.f);
+        boxes[i] = { { random.range(0.f, 4000.f), random.range(0.f, 4000.f) }, { size, size } };
+        velocities[i] = { random.range(-2.f, 2.f), random.range(-2.f, 2.f) };
+    }
+
+    SweepAndPrune sap;
+    sap.reserve(N);
+    std::vector<std::uint32_t> ids(N);
+    for (int i = 0; i < N; ++i) ids[i] = sap.add(boxes[i], static_cast<std::uint32_t>(i));
+    sap.update();
+    sap.clearEvents();
+
+    std::size_t events = 0;
+    double worst = 0.0, total = 0.0;
+    for (int f = 0; f < Frames; ++f) {
+        for (int i = 0; i < N; ++i) {
+            boxes[i].position += velocities[i];
+            sap.move(ids[i], boxes[i]);
+        }
+        const auto start = std::chrono::steady_clock::now();
+        sap.update();
+        const std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+        total += took.count();
+        worst = std::max(worst, took.count());
+        events += sap.added().size() + sap.removed().size();
+        sap.clearEvents();
+    }
+
+    std::size_t pairs = 0;
+    const double brute = bench::seconds([&] {
+        pairs = 0;
+        for (int a = 0; a < N; ++a) {
+            const sf::FloatRect& p = boxes[a];
+            for (int b = a + 1; b < N; ++b) {
+                const sf::FloatRect& q = boxes[b];
+                pairs += p.position.x <= q.position.x + q.size.x and q.position.x <= p.position.x + p.size.x
+                    and p.position.y <= q.position.y + q.size.y and q.position.y <= p.position.y + p.size.y;
+            }
+        }
+    }, 1);
+    CHECK(pairs == sap.pairCount());
+    bench::report("overlapping pairs", static_cast<double>(pairs), "");
+    bench::report("pair events per frame", double(events) / Frames, "");
+    bench::report("sweep and prune: update, mean", total * 1e3 / Frames, "ms");
+    bench::report("sweep and prune: update, worst", worst * 1e3, "ms");
+    bench::report("all pairs: one frame", brute * 1e3, "ms");
+}
@@ -0,0 +1,59 @@
+#include "Bench.h"
+#include "Timeline.h"
+
+// A 100k-state store forked, changed in 100 places, diffed and merged back, next to what
+// copying and comparing a flat array of the same states costs.
+BENCH("timeline: fork, write, diff and merge") {
+    constexpr std::size_t N = 100000;
+    constexpr int Changes = 100;
+    bench::Random random;
+
+    ObstacleStore root;
+    std::vector<ObstacleState> flat;
+    for (std::size_t i = 0; i < N; ++i) {
+        const ObstacleState state{ { random.range(0.f, 4000.f), random.range(0.f, 4000.f) }, true };
+        root.push_back(state);
+        flat.push_back(state);
+    }
+    std::vector<std::size_t> changed;
+    for (int i = 0; i < Changes; ++i) changed.push_back(random.next() % N);
+
+    ObstacleStore fork;
+    const double forkTime = bench::seconds([&] {
+        fork = root;
+        for (std::size_t i : changed) fork.set(i, { fork.get(i).position, false });
+    });
+    std::vector<ObstacleState> flatFork;
+    const double copyTime = bench::seconds([&] {
+        flatFork = flat;
+        for (std::size_t i : changed) flatFork[i].collidable = false;
+    });
+
+    std::size_t diffs = 0;
+    const double diffTime = bench::seconds([&] {
+        diffs = 0;
+        ObstacleStore::diff(root, fork, [&](std::size_t) { ++diffs; });
+    });
+    std::size_t flatDiffs = 0;
+    const double compareTime = bench::seconds([&] {
+        flatDiffs = 0;
+        for (std::size_t i = 0; i < N; ++i) flatDiffs += not (flat[i] == flatFork[i]);
+    });
+
+    ObstacleStore into;
+    ObstacleStore::MergeStats stats;
+    const double mergeTime = bench::seconds([&] {
+        into = root;
+        stats = into.merge(root, fork);
+    });
+
+    bench::report("fork + 100 writes", forkTime * 1e6, "us");
+    bench::report("flat copy + 100 writes", copyTime * 1e6, "us");
+    bench::report("nodes the fork doesn't share", static_cast<double>(fork.uniqueNodes(root)), "");
+    bench::report("diff of the fork against its parent", diffTime * 1e6, "us");
+    bench::report("flat compare", compareTime * 1e6, "us");
+    bench::report("merge of the fork into a fresh copy", mergeTime * 1e6, "us");
+    CHECK(diffs == flatDiffs);
+    CHECK(stats.changed == flatDiffs);
+    CHECK(stats.conflicts == 0);
+}
@@ -0,0 +1,37 @@
+#include "Bench.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    int g_failures = 0;
+}
+
+std::vector<bench::Case>& bench::cases() {
+    static std::vector<Case> all;
+    return all;
+}
+
+void bench::fail(const char* file, int line, const char* expression) {
+    std::printf("  FAILED %s:%d: %s\n", file, line, expression);
+    ++g_failures;
+}
+
+void bench::report(const char* label, double value, const char* unit) {
+    std::printf("  %-48s %12.3f %s\n", label, value, unit);
+}
+
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : "";
+    auto& all = bench::cases();
+    std::sort(all.begin(), all.end(), [](const bench::Case& a, const bench::Case& b) { return std::strcmp(a.name, b.name) < 0; });
+    int ran = 0;
+    for (const bench::Case& c : all) {
+        if (not std::strstr(c.name, filter)) continue;
+        std::printf("%s\n", c.name);
+        c.run();
+        ++ran;
+    }
+    std::printf("%d cases, %d failed checks\n", ran, g_failures);
+    return g_failures == 0 ? 0 : 1;
+}